@@ -24,15 +24,44 @@
 //  along with Arduino_RX_ADF7242.ino.  If not, see <http://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include <ADF7242.h>
+#include <ADIS16480.h>
+#include <Profiler.h>
 #include <SPI.h>
+#include <SPITransport.h>
+#include <Telemetry.h>
 
 //#define DEBUG // Comment out this line to disable DEBUG mode
+#define LEGACY_SERIAL // Comment out this line to relay framed telemetry over USB instead of roll, pitch, yaw, 0xFF
 
 // Variables
 unsigned char roll = 0;
 unsigned char pitch = 0;
 unsigned char yaw = 0;
 unsigned char serialSyncWord = 0xFF; // Used to synchronize serial data received by GUI on PC
+uint8_t payload[ADF7242_MAX_PAYLOAD]; // Received packet payload
+uint8_t serialFrame[TELEMETRY_MAX_ENCODED]; // Sample re-encoded for the USB serial port
+uint16_t serialSeq = 0; // Sequence number of the next serial frame
+
+#define RADIO_IRQ_PIN 9 // ADF7242 IRQ1 output
+
+// Set by the IRQ1 interrupt, consumed by loop()
+volatile bool irqPending = false;
+volatile unsigned long irqMicros = 0; // micros() at the IRQ1 edge
+
+// Link statistics
+unsigned long packetCount = 0; // Packets relayed since power up
+unsigned long packetsPerSecond = 0; // Packets relayed during the last full second
+unsigned long rateCount = 0; // Packets relayed in the current second
+unsigned long rateMillis = 0; // Start of the current second
+unsigned long latencyLast = 0; // IRQ1 edge to end of serial write for the last packet [us]
+unsigned long latencyMax = 0; // Worst case of the above since power up [us]
+unsigned long frameErrors = 0; // Packets rejected by the telemetry decoder (COBS, length, CRC, version)
+unsigned long framesLost = 0; // Frames missing from the TX sequence numbers
+uint16_t lastSeq = 0; // Sequence number of the last good frame
+bool seqValid = false; // lastSeq holds a received sequence number
+unsigned long samplesRelayed = 0; // Individual samples written to the serial port
+unsigned long usefulBytes = 0; // Sample bytes received
+unsigned long airBytes = 0; // Bytes the received packets occupied on air
 
 ADF7242 Rx(10); // Instantiate ADF7242 Rx(Chip Select)
 
@@ -64,47 +93,147 @@ void setup() {
   Rx.cfgCRC(0);             // CRC - Disable automatic CRC = 1, else 0
   Rx.cfgBasicPreamble();    // FSK preamble configuration
   Rx.PHY_RDY();             // System calibration
-  Rx.receive();             // Set transceiver to receive mode
   
   // Clear receive buffer to all 0x00
   for(int i = 0x000; i < 0x005; ++i) {
     Rx.regWrite(i, 0x00);
   }
+
+  // Raise IRQ1 when a packet has been received, then start listening
+  Rx.cfgIRQ(0x00, IRQ_RX_PKT_RCVD);
+  pinMode(RADIO_IRQ_PIN, INPUT);
+  attachInterrupt(RADIO_IRQ_PIN, radioIRQ, RISING);
+  Rx.receive();             // Set transceiver to receive mode
+  rateMillis = millis();
 }
 
-void loop() {
-  
-  #ifndef DEBUG // If NOT in DEBUG mode
-  
-    Rx.receive();
-    delay(2);
-    // Only output data to the serial port if the CRC matches and data is valid
-    if((Rx.statusRead() & 0x40) == 0x40) {
-      roll = Rx.regRead(0x002);
-      pitch = Rx.regRead(0x003);
-      yaw = Rx.regRead(0x004);
-      Serial.write(roll); // Write roll data to serial connection
-      Serial.write((pitch * -1)); // Write pitch data to serial connection
-      Serial.write(yaw); // Write yaw data to serial connection
-      Serial.write(0xFF); // Write synchronization word to serial connection
-    }
-    
-  #endif
+// Cast a full resolution Euler angle to the legacy 8-bit format. 0xFF is reserved for synchronization.
+unsigned char legacyAngle(int16_t angle) {
+  unsigned char legacy = (unsigned char)((uint16_t)angle >> 8);
+  if(legacy == 0xFF) { // 0xFF represents 360 degrees
+    legacy = 0; // This makes sense since 0 and 360 degrees are the same place
+  }
+  return(legacy);
+}
 
-  // Write IMU data and status to serial port
-  #ifdef DEBUG // If IN DEBUG mode
-    Rx.receive();
-    Serial.print(Rx.statusRead());
-    Rx.dumpISB();
-    for(int i = 0x000; i < 0x005; ++i) {
-      int recPac = Rx.regRead(i);
-      Serial.print("Packet buffer contencts for address 0x");
-      Serial.print(i, HEX);
-      Serial.print(" : 0x");
-      Serial.println(recPac, HEX);
+// Write one received sample to the serial port, either in the legacy format or as its own frame
+void relaySample(uint8_t type, const uint8_t* data, uint8_t size) {
+  #ifdef LEGACY_SERIAL // Format expected by the Processing demos
+    int16_t euler[3];
+    if(type == TELEM_TIMED_ATTITUDE && size == sizeof(TelemetryTimedAttitude)) {
+      const TelemetryTimedAttitude* attitude = (const TelemetryTimedAttitude*)data;
+      euler[0] = attitude->roll;
+      euler[1] = attitude->pitch;
+      euler[2] = attitude->yaw;
     }
+    else if(type == TELEM_SAMPLE && size == sizeof(ADIS16480Sample)) {
+      const ADIS16480Sample* imu = (const ADIS16480Sample*)data;
+      euler[0] = imu->euler[0];
+      euler[1] = imu->euler[1];
+      euler[2] = imu->euler[2];
+    }
+    else {
+      return;
+    }
+    roll = legacyAngle(euler[0]);
+    pitch = legacyAngle(euler[1]);
+    yaw = legacyAngle(euler[2]);
+    Serial.write(roll); // Write roll data to serial connection
+    Serial.write((pitch * -1)); // Write pitch data to serial connection
+    Serial.write(yaw); // Write yaw data to serial connection
+    Serial.write(serialSyncWord); // Write synchronization word to serial connection
+  #else
+    size_t n = telemetryEncode(type, serialSeq++, data, size, serialFrame, sizeof(serialFrame));
+    Serial.write(serialFrame, n);
   #endif
+  ++samplesRelayed;
+}
+
+// IRQ1 interrupt only timestamps the edge. The SPI work happens in loop().
+void radioIRQ() {
+  irqMicros = micros();
+  irqPending = true;
+}
+
+void loop() {
   
-  delay(10);
+  // Service IRQ1: read and clear the source, fetch the packet, and re-arm RX
+  if(irqPending) {
+    noInterrupts();
+    unsigned long edgeMicros = irqMicros;
+    irqPending = false;
+    interrupts();
+
+    int len = Rx.serviceIRQ(payload, sizeof(payload));
+    TelemetryFrame rxFrame;
+    if(len > 0 && telemetryDecode(payload, len, rxFrame) != TELEMETRY_OK) {
+      ++frameErrors; // Corrupted packet, wait for the next one
+    }
+    else if(len > 0) {
+      uint16_t gap = (uint16_t)(rxFrame.seq - lastSeq - 1);
+      if(seqValid && gap < 0x8000) { // A backwards jump means the transmitter restarted
+        framesLost += gap;
+      }
+      lastSeq = rxFrame.seq;
+      seqValid = true;
+      // Unpack a batch into individual time-stamped samples, pass anything else through whole
+      uint8_t recordType;
+      uint8_t recordSize;
+      const uint8_t* records;
+      uint8_t count = telemetryBatchRecords(rxFrame, recordType, recordSize, records);
+      if(rxFrame.type != TELEM_BATCH) {
+        recordType = rxFrame.type;
+        recordSize = rxFrame.length;
+        records = rxFrame.payload;
+        count = 1;
+      }
+      usefulBytes += count * recordSize;
+      airBytes += Rx.airBytes(len);
+      #ifndef DEBUG // If NOT in DEBUG mode
+        for(uint8_t i = 0; i < count; ++i) {
+          relaySample(recordType, records + i * recordSize, recordSize);
+        }
+      #endif
+      // Write frame header and status to serial port
+      #ifdef DEBUG // If IN DEBUG mode
+        Serial.print(Rx.statusRead());
+        Serial.print(" Frame seq ");
+        Serial.print(rxFrame.seq);
+        Serial.print(" type 0x");
+        Serial.print(rxFrame.type, HEX);
+        Serial.print(" length ");
+        Serial.print(rxFrame.length);
+        Serial.print(" samples ");
+        Serial.println(count);
+      #endif
+      latencyLast = micros() - edgeMicros;
+      if(latencyLast > latencyMax) {
+        latencyMax = latencyLast;
+      }
+      ++packetCount;
+      ++rateCount;
+    }
+  }
+
+  // Roll the packets/s counter over once a second
+  if(millis() - rateMillis >= 1000) {
+    packetsPerSecond = rateCount;
+    rateCount = 0;
+    rateMillis += 1000;
+    #ifdef DEBUG
+      Serial.print("Packets/s: ");
+      Serial.print(packetsPerSecond);
+      Serial.print(" Latency last/max [us]: ");
+      Serial.print(latencyLast);
+      Serial.print("/");
+      Serial.print(latencyMax);
+      Serial.print(" Frame errors/lost: ");
+      Serial.print(frameErrors);
+      Serial.print("/");
+      Serial.print(framesLost);
+      Serial.print(" Payload efficiency [%]: ");
+      Serial.println(airBytes ? 100.0f * usefulBytes / airBytes : 0.0f);
+    #endif
+  }
   
 }
@@ -25,7 +25,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <ADIS16480.h>
+#include <Profiler.h>
 #include <SPI.h>
+#include <SPITransport.h>
 
 //#define DEBUG // Comment out this line to disable DEBUG mode
 
@@ -34,6 +36,8 @@ unsigned char roll = 0;
 unsigned char pitch = 0;
 unsigned char yaw = 0;
 unsigned char serialSyncWord = 0xFF; // Used to synchronize serial data received by GUI on PC
+const uint16_t attitudeRegs[3] = {ROLL_C23_OUT, PITCH_C31_OUT, YAW_C32_OUT}; // Registers read on every data ready
+uint16_t attitude[3]; // Raw roll, pitch, and yaw register contents
 unsigned char temp = 0;
 
 ADIS16480 IMU(10,8,6); // Instantiate ADIS16480 IMU(Chip Select, Data Ready, HW Reset) 
@@ -69,9 +73,10 @@ void setup() {
 
 // Read IMU data, cast it, and transmit it.
 void grabSensorData() {
-  roll = (char)(IMU.regRead(ROLL_C23_OUT) >> 8);  // Read roll register and cast to char
-  pitch = (char)(IMU.regRead(PITCH_C31_OUT) >> 8);  // Read pitch register and cast to char
-  yaw = (char)(IMU.regRead(YAW_C32_OUT) >> 8);  // Read yaw register and cast to char
+  IMU.regReadBurst(attitudeRegs, attitude, 3); // Read roll, pitch, and yaw in one pipelined burst
+  roll = (char)(attitude[0] >> 8);  // Cast roll register to char
+  pitch = (char)(attitude[1] >> 8);  // Cast pitch register to char
+  yaw = (char)(attitude[2] >> 8);  // Cast yaw register to char
   // 0xFF is a reserved word used for data synchronization
   if(roll == 0xFF) { // 0xFF represents 360 degrees
     roll = 0; // This makes sense since 0 and 360 degrees are the same place
@@ -26,15 +26,68 @@
 
 #include <ADF7242.h>
 #include <ADIS16480.h>
+#include <Profiler.h>
+#include <Quaternion.h>
+#include <SampleQueue.h>
 #include <SPI.h>
+#include <SPIBus.h>
+#include <SPITransport.h>
+#include <Telemetry.h>
 
 //#define DEBUG // Comment out this line to disable DEBUG mode
+//#define PROBE_SPI_CLOCK // Uncomment to search for the fastest reliable output data clock of each chip at start up
+#define LEGACY_SERIAL // Comment out this line to stream framed telemetry over USB instead of roll, pitch, yaw, 0xFF
+//#define ONBOARD_ATTITUDE // Uncomment to send attitude integrated from the delta angles instead of the on-chip EKF angles
+
+#define SAMPLES_PER_PACKET 8 // Samples aggregated into one radio packet (clipped to what fits, 11 at most)
+#define PACKET_DEADLINE_US 50000 // Send a partial packet once its oldest sample is this old [us]
 
 // Define Variables
 unsigned char roll = 0;
 unsigned char pitch = 0;
 unsigned char yaw = 0;
 unsigned char serialSyncWord = 0xFF; // Used to synchronize serial data received by GUI on PC
+uint16_t radioSeq = 0; // Sequence number of the next radio frame
+uint16_t serialSeq = 0; // Sequence number of the next serial frame
+uint8_t frame[TELEMETRY_ENCODED_SIZE(sizeof(ADIS16480Sample))]; // Encoded serial telemetry frame
+uint8_t radioFrame[ADF7242_MAX_PAYLOAD + 1]; // Encoded radio frame, plus the 0x00 delimiter that is not sent
+
+// Radio aggregation. The trailing 0x00 is not sent, so one more encoded byte fits the packet RAM.
+TelemetryBatch radioBatch(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), SAMPLES_PER_PACKET,
+                          PACKET_DEADLINE_US, ADF7242_MAX_PAYLOAD + 1);
+
+// Payload efficiency: sample bytes delivered to the packet RAM over bytes put on air
+unsigned long usefulBytes = 0;
+unsigned long airBytes = 0;
+unsigned long packetsSent = 0;
+unsigned long reportMillis = 0; // Start of the current DEBUG report period
+unsigned long samplesTaken = 0; // Samples drained from the queue in the current DEBUG report period
+
+// IMU samples captured by the data ready interrupt, stamped with micros() at the data ready edge
+SampleQueue<ADIS16480Sample, 16> sampleQueue; // Hands samples from the interrupt to loop()
+ADIS16480Sample sample; // Sample currently being transmitted by loop()
+
+#ifdef ONBOARD_ATTITUDE
+Quaternion attitude; // Integrated from X/Y/Z_DELTANG, started from the EKF angles of the first sample. ISR only.
+bool attitudeStarted = false;
+#endif
+
+SPIBus spiBus; // Owns the SPI settings of both chips and switches modes only when needed
+int imuBus; // SPIBus handle of the ADIS16480 (SPI_MODE3, 1 MHz)
+int radioBus; // SPIBus handle of the ADF7242 (SPI_MODE0, 4 MHz)
+
+#ifdef PROBE_SPI_CLOCK
+// Output data clocks tried by the start up probe, ascending, and checks per rate
+const uint32_t probeClocks[] = {1000000, 2000000, 4000000, 6000000, 8000000, 12000000, 15000000};
+#define PROBE_SOAK 1000
+#endif
+
+// Hot path probes, compiled out unless PROFILE is defined in Profiler.h. Send 'P' over USB serial for a dump (framed telemetry only).
+PROFILE_PROBE(captureProbe, "captureSample");
+PROFILE_PROBE(sendProbe, "sendWirelessSensorData");
+#ifdef ONBOARD_ATTITUDE
+PROFILE_PROBE(attitudeProbe, "integrateAttitude");
+#endif
 
 ADF7242 Tx(7); // Instantiate ADF7242 Tx(Chip Select)
 ADIS16480 IMU(10,8,6); // Instantiate ADIS16480 IMU(Chip Select, Data Ready, HW Reset) 
@@ -44,21 +97,32 @@ void setup() {
   
   SPI.begin(); //Start SPI
   Serial.begin(115200); //Start USB Serial
+  PROFILE_BEGIN();          // Start the cycle counter used by the profiler
+  imuBus = spiBus.addDevice(ADIS16480_SPI_CLOCK, MSBFIRST, ADIS16480_SPI_MODE);
+  radioBus = spiBus.addDevice(ADF7242_SPI_CLOCK, MSBFIRST, ADF7242_SPI_MODE);
+  spiBus.setClock(imuBus, SPIBUS_DATA, ADIS16480_SPI_DATA_CLOCK); // Sample reads run faster than configuration
+  spiBus.setClock(radioBus, SPIBUS_DATA, ADF7242_SPI_DATA_CLOCK); // So do packet writes
 
   // ADIS16480 IMU configuration
   delay(600);
-  IMU.configSPI();          // Begin the SPI transaction
-  IMU.dummySPIWrite();      // Dummy write to force SPI Mode change
+  spiBus.begin(imuBus);     // Begin the SPI transaction, switching SPI mode if needed
   IMU.reset(2000);          // Reset ADIS16480 during cold start up
-  IMU.regRead(PROD_ID);     // Read the product ID register
-  IMU.regWrite(FNCTIO_CTRL, 0x0D); // Enable data ready on DIO2 (0x0D)
-  IMU.regWrite(DEC_RATE, 0x51); // Set decimation to 30Hz
+  ADIS16480RegOp imuConfig[] = {
+    {PROD_ID, 0, false},       // Read the product ID register
+    {FNCTIO_CTRL, 0x0D, true}, // Enable data ready on DIO2 (0x0D)
+    {DEC_RATE, 0x51, true},    // Set decimation to 30Hz
+  };
+  IMU.regBatch(imuConfig, 3); // Apply the configuration with one page switch
+  IMU.refresh();            // Load the configuration register shadow in one sweep
+#ifdef DEBUG
+  Serial.print("DEC_RATE: ");
+  Serial.println(IMU.config().decRate); // Served from the shadow, no SPI
+#endif
   //IMU.tare();               // Tare the ADIS16480 during cold start up
-  IMU.closeSPI();           // End the SPI transaction
+  spiBus.end();             // End the SPI transaction
 
   // ADF7242 RFIC configuration
-  Tx.configSPI();           // Begin the SPI transaction
-  Tx.dummySPIWrite();       // Dummy SPI write to force a SPI mode update
+  spiBus.begin(radioBus);   // Begin the SPI transaction, switching SPI mode if needed
   Tx.reset();               // Reset ADF7242 transceiver during cold start up
   Tx.idle();                // Idle ADF7242 transceiver after cold start up
 
@@ -74,24 +138,46 @@ void setup() {
   Tx.cfgBasicPreamble();    // FSK preamble configuration
   
   // Configure TX packet buffer
-  Tx.cfgPB(0x080, 0x000);   // Sets Tx/Rx packet buffer pointers
-  Tx.regWrite(0x081, 0x05); // Set packet length LSB
-  Tx.regWrite(0x080, 0x00); // Set packet length MSB
+  Tx.cfgPB(0x080, 0x000);   // Sets Tx/Rx packet buffer pointers. Packet length is written by writePacket()
   Tx.PHY_RDY();             // System calibration
-  Tx.closeSPI();            // End the SPI transaction
+  spiBus.end();             // End the SPI transaction
   
+  #ifdef PROBE_SPI_CLOCK
+    // Only reads are issued at trial rates, and the radio is probed after syncWord() wrote the pattern it checks
+    spiBus.begin(imuBus);   // Select page 0 once at the configuration clock, so the IMU checks only read
+    IMU.regRead(PROD_ID);
+    spiBus.end();
+    Serial.print("ADIS16480 data clock [Hz]: ");
+    Serial.println(spiBus.probe(imuBus, imuLinkCheck, 0, probeClocks, sizeof(probeClocks) / sizeof(probeClocks[0]), PROBE_SOAK));
+    Serial.print("ADF7242 data clock [Hz]: ");
+    Serial.println(spiBus.probe(radioBus, radioLinkCheck, 0, probeClocks, sizeof(probeClocks) / sizeof(probeClocks[0]), PROBE_SOAK));
+  #endif
+
   // Set interrupt pin on the MCU as an input and attach an interrupt
-  attachInterrupt(8, transmitData, RISING); //Use GPIO 2 when using the development platform
+  SPI.usingInterrupt(8);    // Hold off data ready while loop() is talking to the radio
+  attachInterrupt(8, captureSample, RISING); //Use GPIO 2 when using the development platform
+}
+
+#ifdef PROBE_SPI_CLOCK
+// Known-register checks run by spiBus.probe()
+bool imuLinkCheck(void* arg) {
+  return(IMU.linkCheck());
+}
+
+bool radioLinkCheck(void* arg) {
+  return(Tx.linkCheck());
 }
+#endif
 
-// Read IMU data, cast it, and transmit it.
-void grabSensorData() {
-  IMU.configSPI();          // Begin SPI transactions
-  IMU.dummySPIWrite();      // Dummy write to force SPI Mode change
-  roll = (char)(IMU.regRead(ROLL_C23_OUT) >> 8);  // Read roll register and cast to char
-  pitch = (char)(IMU.regRead(PITCH_C31_OUT) >> 8);  // Read pitch register and cast to char
-  yaw = (char)(IMU.regRead(YAW_C32_OUT) >> 8);  // Read yaw register and cast to char
-  // 0xFF is a reserved word used for data synchronization
+// Take the oldest captured sample off the queue and cast it. Returns false if there is none.
+bool grabSensorData() {
+  if(!sampleQueue.pop(sample)) {
+    return(false);
+  }
+  roll = (char)((uint16_t)sample.euler[0] >> 8);  // Cast roll register to char
+  pitch = (char)((uint16_t)sample.euler[1] >> 8);  // Cast pitch register to char
+  yaw = (char)((uint16_t)sample.euler[2] >> 8);  // Cast yaw register to char
+  // 0xFF is a reserved word used for data synchronization in the legacy serial format
   if(roll == 0xFF) { // 0xFF represents 360 degrees
     roll = 0; // This makes sense since 0 and 360 degrees are the same place
   }
@@ -101,39 +187,153 @@ void grabSensorData() {
   if(yaw == 0xFF) { // 0xFF represents 360 degrees
     yaw = 0; // This makes sense since 0 and 360 degrees are the same place
   }
-  IMU.closeSPI(); // End SPI transaction
+  return(true);
 }
 
-// Transmit IMU data via ADF7242
+#ifdef ONBOARD_ATTITUDE
+// Apply the sample's delta angles to the fixed-point attitude and put its Euler angles in the sample.
+// Runs in captureSample() for every sample read, so a full queue cannot drop rotation.
+void integrateAttitude(ADIS16480Sample &captured) {
+  PROFILE_SCOPE(attitudeProbe);
+  int16_t euler[3]; // Aligned copies, the sample is packed
+  int32_t deltAng[3];
+  for(int i = 0; i < 3; ++i) {
+    euler[i] = captured.euler[i];
+    deltAng[i] = captured.deltAng[i];
+  }
+  if(!attitudeStarted) {
+    quatFromEuler(euler, attitude); // The EKF already accounts for this sample's rotation
+    attitudeStarted = true;
+  }
+  else {
+    quatIntegrate(attitude, deltAng);
+  }
+  quatToEuler(attitude, euler);
+  for(int i = 0; i < 3; ++i) {
+    captured.euler[i] = euler[i];
+  }
+}
+#endif
+
+// Add the time-stamped attitude to the radio batch. Returns true when the batch should be sent.
+bool batchWirelessSensorData() {
+  TelemetryTimedAttitude record;
+  record.timestamp = sample.timestamp;
+  record.roll = sample.euler[0];
+  record.pitch = sample.euler[1];
+  record.yaw = sample.euler[2];
+  return(radioBatch.add(&record, sample.timestamp));
+}
+
+// Transmit the batched samples via ADF7242 as one telemetry frame
 void sendWirelessSensorData() {
-  Tx.configSPI(); // Begin SPI transaction
-  Tx.dummySPIWrite(); // Dummy write to force SPI Mode change
-  delay(1);
-  Tx.regWrite(0x082, roll); // Write roll data to ADF7242 packet buffer
-  Tx.regWrite(0x083, pitch); // Write pitch data to ADF7242 packet buffer
-  Tx.regWrite(0x084, yaw); // Write yaw data to ADF7242 packet buffer
+  PROFILE_SCOPE(sendProbe);
+  usefulBytes += radioBatch.count() * sizeof(TelemetryTimedAttitude);
+  size_t len = radioBatch.encode(radioSeq++, radioFrame, sizeof(radioFrame));
+  if(len == 0) {
+    return;
+  }
+  airBytes += Tx.airBytes(len - 1);
+  ++packetsSent;
+  spiBus.begin(radioBus, SPIBUS_DATA); // Begin SPI transaction at the packet clock, switching SPI mode if needed
+  Tx.writePacket(radioFrame, len - 1); // The radio packet length delimits the frame, so the trailing 0x00 is not sent
   Tx.transmit();  // Transmit packet buffer
-  Tx.closeSPI();  // End SPI transaction
+  spiBus.end();   // End SPI transaction
 }
 
 // Transmit IMU data via USB Serial port.
 void sendSerialSensorData() {
-  Serial.write(roll); // Write roll data to serial connection
-  Serial.write(pitch); // Write pitch data to serial connection
-  Serial.write(yaw); // Write yaw data to serial connection
-  Serial.write(serialSyncWord); // Write synchronization word to serial connection
+  #ifdef LEGACY_SERIAL // Format expected by the Processing demos
+    Serial.write(roll); // Write roll data to serial connection
+    Serial.write(pitch); // Write pitch data to serial connection
+    Serial.write(yaw); // Write yaw data to serial connection
+    Serial.write(serialSyncWord); // Write synchronization word to serial connection
+  #else
+    size_t len = telemetryEncode(TELEM_SAMPLE, serialSeq++, (const uint8_t*)&sample, sizeof(ADIS16480Sample), frame, sizeof(frame));
+    Serial.write(frame, len); // Frame including its 0x00 delimiter
+  #endif
 }
 
-// Interrupt routine will grab data from the IMU and transmit it via the ADF7242 and SPI
-void transmitData() {
-  grabSensorData();
-  sendWirelessSensorData();
-  sendSerialSensorData();
+#if defined(PROFILE) && !defined(LEGACY_SERIAL)
+// Send every probe as a TELEM_PROFILE frame, then start measuring afresh. Decode with host/teledump.
+void sendProfile() {
+  uint8_t buf[TELEMETRY_ENCODED_SIZE(sizeof(ProfileRecord))];
+  ProfileRecord rec;
+  for(int i = 0; profileSnapshot(i, rec); ++i) {
+    size_t len = telemetryEncode(TELEM_PROFILE, serialSeq++, (const uint8_t*)&rec, sizeof(rec), buf, sizeof(buf));
+    Serial.write(buf, len);
+  }
+  profileClear();
+}
+#endif
+
+// Interrupt routine only captures the IMU sample and its timestamp, and integrates the attitude if
+// ONBOARD_ATTITUDE is on. Everything else happens in loop().
+void captureSample() {
+  PROFILE_SCOPE(captureProbe);
+  ADIS16480Sample captured;
+  uint32_t timestamp = micros(); // Time of the data ready edge
+  spiBus.begin(imuBus, SPIBUS_DATA); // Begin SPI transaction at the data clock. No mode switch unless the radio used the bus last
+  IMU.readSample(captured, timestamp); // Read every output register in one pipelined burst, count SEQ_CNT gaps and jitter
+  spiBus.end();             // End SPI transaction
+  #ifdef ONBOARD_ATTITUDE
+    integrateAttitude(captured); // Replaces the EKF angles, before the sample can be lost to an overflow
+  #endif
+  sampleQueue.push(captured); // Counted in sampleQueue.overflows() if loop() has fallen behind
 }
 
 void loop() {
   
-  // Program is entirely interrupt driven. Nothing to do here!
+  // Drain every sample captured since the last pass to the radio batch and USB serial
+  while(grabSensorData()) {
+    ++samplesTaken;
+    if(batchWirelessSensorData()) {
+      sendWirelessSensorData();
+    }
+    sendSerialSensorData();
+  }
+
+  #if defined(PROFILE) && !defined(LEGACY_SERIAL) // Frames would corrupt the roll, pitch, yaw, 0xFF stream
+    if(Serial.available() && Serial.read() == 'P') {
+      sendProfile();
+    }
+  #endif
+
+  // Don't let a partial batch wait past its deadline
+  if(radioBatch.due(micros())) {
+    sendWirelessSensorData();
+  }
+
+  #ifdef DEBUG
+    if(millis() - reportMillis >= 1000) {
+      reportMillis += 1000;
+      Serial.print("Samples/packet: ");
+      Serial.print(packetsSent ? (float)usefulBytes / sizeof(TelemetryTimedAttitude) / packetsSent : 0.0f);
+      Serial.print(" Payload efficiency [%]: ");
+      Serial.println(airBytes ? 100.0f * usefulBytes / airBytes : 0.0f);
+      noInterrupts(); // The data ready interrupt updates the bus and acquisition counters too
+      SPIBusCounters bus = spiBus.stats();
+      spiBus.clearStats();
+      ADIS16480AcqStats acq = IMU.acqStats();
+      IMU.clearAcqStats();
+      interrupts();
+      Serial.print("SPI mode switches/sample: ");
+      Serial.print(samplesTaken ? (float)bus.modeSwitches / samplesTaken : 0.0f);
+      Serial.print(" Bus idle [us]/sample: ");
+      Serial.println(samplesTaken ? (float)bus.idleMicros / samplesTaken : 0.0f);
+      samplesTaken = 0;
+      Serial.print("SEQ_CNT skipped: ");
+      Serial.print(acq.skipped);
+      Serial.print(" Queue overflows: ");
+      Serial.print(sampleQueue.overflows());
+      Serial.print(" Data ready period [us]: ");
+      Serial.print(acq.intervals ? (float)acq.intervalSum / acq.intervals : 0.0f);
+      Serial.print(" expected ");
+      Serial.print(1000000.0f * (IMU.config().decRate + 1) / ADIS16480_BASE_RATE); // DEC_RATE from the register shadow
+      Serial.print(" jitter p-p [us]: ");
+      Serial.println(acq.intervals ? acq.maxInterval - acq.minInterval : 0);
+    }
+  #endif
   
 }
 
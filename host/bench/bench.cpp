@@ -0,0 +1,643 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  bench.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Drives the real ADIS16480 and ADF7242 driver sources against the simulated chips in host/sim and
+//  reports, per operation, the SPI frames and bytes, the modeled bus time (elapsed, clocking, and
+//  stall time owed to the chips), and the host CPU time spent in the driver and the bus model. The
+//  modeled figures are what the operation costs on the Teensy bus; the CPU figure only tracks
+//  regressions in the driver code paths. A second section runs two radios over a lossy simulated link,
+//  configured as the TX and RX sketches configure them, and reports goodput and latency. A third pushes
+//  a sample stream through a pseudo-terminal into TelemetryIngest, as a USB CDC link would deliver it.
+//  A fourth records a long session to a SampleLog and times opening it and reading short windows.
+//  A fifth integrates delta angles with the fixed-point quaternion library and compares it to the
+//  same integration in double precision.
+//  Output is one JSON object on stdout.
+//
+//  Build:  cmake -S host -B build && cmake --build build
+//  Usage:  bench [iterations]   (10000 when omitted)
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <HostSPITransport.h>
+#include <ADIS16480.h>
+#include <ADF7242.h>
+#include <ADIS16480Sim.h>
+#include <ADF7242Sim.h>
+#include <ADF7242Link.h>
+#include <Telemetry.h>
+#include <TelemetryIngest.h>
+#include <SampleLog.h>
+#include <Quaternion.h>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Pins as wired on the TX board
+#define IMU_CS 10
+#define IMU_DR 8
+#define IMU_RST 6
+#define RADIO_CS 7
+#define RADIO_IRQ 2
+
+// Link run: packets sent back to back, each a batch as the TX sketch builds it
+#define LINK_PACKETS 1000
+#define LINK_SAMPLES_PER_PACKET 8
+#define LINK_LOSS 0.01
+#define LINK_CORRUPTION 0.01
+#define LINK_DELAY_NS 2000
+#define LINK_STEP_NS 10000 // Lockstep granularity of the two boards
+
+// Ingest run: TELEM_SAMPLE frames as the TX sketch streams them over USB, with a burst of noise now and then
+#define INGEST_FRAMES 200000
+#define INGEST_NOISE_EVERY 10000
+
+// Sample log section
+#define LOG_ROWS 1000000 // About 68 minutes at 246 Hz
+#define LOG_QUERIES 1000
+#define LOG_WINDOW_US 100000 // Time span of one query
+
+// Attitude integration section: 10 minutes of tumbling at the 2460 Hz native rate
+#define QUAT_UPDATES 1476000
+#define QUAT_RATE_HZ 2460.0
+#define ADIS16480_DELTANG_SCALE_D (720.0 / 2147483648.0) // deg per DELTANG LSB, in double
+
+// Simulated chips on one modeled bus, with the drivers under test
+struct Rig {
+  HostSPITransport bus;
+  ADIS16480Sim imuSim;
+  ADF7242Sim radioSim;
+  ADIS16480 imu;
+  ADF7242 radio;
+
+  Rig() : imuSim(IMU_RST), imu(IMU_CS, IMU_DR, IMU_RST, bus), radio(RADIO_CS, bus) {
+    bus.setRecording(false);
+    bus.attach(IMU_CS, &imuSim);
+    bus.attachPin(IMU_DR, &imuSim);
+    bus.attachPin(IMU_RST, &imuSim);
+    bus.attach(RADIO_CS, &radioSim);
+  }
+};
+
+typedef void (*BenchOp)(Rig &rig, unsigned long i);
+
+// One benchmarked operation
+struct Bench {
+  const char* name;
+  uint32_t clock; // SCK rate the operation runs at, as in the TX sketch
+  uint8_t dataMode;
+  BenchOp setup; // Untimed preparation, may be 0
+  BenchOp op;
+};
+
+static uint8_t payload[ADF7242_MAX_PAYLOAD];
+static uint8_t rxBuf[ADF7242_MAX_PAYLOAD];
+
+static void adisRegRead(Rig &rig, unsigned long i) {
+  rig.imu.regRead(PROD_ID);
+}
+
+static void adisShadowSetup(Rig &rig, unsigned long i) {
+  rig.imu.refresh();
+}
+
+static void adisShadowRead(Rig &rig, unsigned long i) {
+  rig.imu.regRead(DEC_RATE);
+}
+
+static void adisReadSample(Rig &rig, unsigned long i) {
+  ADIS16480Sample sample;
+  rig.imuSim.dataReady();
+  rig.imu.readSample(sample, rig.bus.micros());
+}
+
+static void adfWritePacket88(Rig &rig, unsigned long i) {
+  rig.radio.writePacket(payload, 88);
+}
+
+static void adfWritePacketMax(Rig &rig, unsigned long i) {
+  rig.radio.writePacket(payload, ADF7242_MAX_PAYLOAD);
+}
+
+static void adfReadPacketSetup(Rig &rig, unsigned long i) {
+  rig.radioSim.receivePacket(payload, 88);
+}
+
+static void adfReadPacket(Rig &rig, unsigned long i) {
+  ADF7242RxInfo info;
+  rig.radio.readPacket(rxBuf, sizeof(rxBuf), &info);
+}
+
+static void adfInitFSK(Rig &rig, unsigned long i) {
+  rig.radio.initFSK(5);
+}
+
+static const Bench benches[] = {
+  {"adis_reg_read", ADIS16480_SPI_CLOCK, ADIS16480_SPI_MODE, 0, adisRegRead},
+  {"adis_reg_read_shadowed", ADIS16480_SPI_CLOCK, ADIS16480_SPI_MODE, adisShadowSetup, adisShadowRead},
+  {"adis_read_sample", ADIS16480_SPI_DATA_CLOCK, ADIS16480_SPI_MODE, 0, adisReadSample},
+  {"adf_write_packet_88", ADF7242_SPI_DATA_CLOCK, ADF7242_SPI_MODE, 0, adfWritePacket88},
+  {"adf_write_packet_max", ADF7242_SPI_DATA_CLOCK, ADF7242_SPI_MODE, 0, adfWritePacketMax},
+  {"adf_read_packet_88", ADF7242_SPI_DATA_CLOCK, ADF7242_SPI_MODE, adfReadPacketSetup, adfReadPacket},
+  {"adf_init_fsk", ADF7242_SPI_CLOCK, ADF7242_SPI_MODE, 0, adfInitFSK},
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Runs one operation iterations times on a fresh rig and prints its JSON
+// record. Modeled time comes from the bus counters, CPU time from
+// steady_clock around the whole loop.
+////////////////////////////////////////////////////////////////////////////
+static void run(const Bench &b, unsigned long iterations, bool last) {
+  Rig rig;
+  rig.bus.beginTransaction(b.clock, MSBFIRST, b.dataMode);
+  if (b.setup) {
+    b.setup(rig, 0);
+  }
+  rig.imu.clearStallMicros();
+  rig.radio.clearStallMicros();
+  rig.bus.resetStats();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < iterations; ++i) {
+    b.op(rig, i);
+  }
+  std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+  SPIBusStats s = rig.bus.stats();
+  double n = (double)iterations;
+  double cpuNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  printf("    {\"name\": \"%s\", \"iterations\": %lu, \"clock_hz\": %u, \"frames\": %.2f, \"bytes\": %.2f, "
+         "\"bus_us\": %.3f, \"busy_us\": %.3f, \"stall_us\": %.3f, \"cpu_ns\": %.1f}%s\n",
+         b.name, iterations, b.clock, s.frames / n, s.bytes / n,
+         s.elapsedNs / n / 1000.0, s.busyNs / n / 1000.0, s.stallNs / n / 1000.0, cpuNs / n, last ? "" : ",");
+}
+
+// One board of the link run: bus, radio model, and driver
+struct Node {
+  HostSPITransport bus;
+  ADF7242Sim sim;
+  ADF7242 radio;
+
+  Node(int cs, int irq) : sim(irq), radio(cs, bus) {
+    bus.setRecording(false);
+    bus.attach(cs, &sim);
+    bus.attachPin(irq, &sim);
+  }
+
+  // Radio configuration shared by both sketches, then IRQ1 on the given sources
+  void bringUp(unsigned char irqSources) {
+    radio.configSPI();
+    radio.reset();
+    radio.idle();
+    radio.initFSK(5);
+    radio.setMode(0x04);
+    radio.chFreq(2450);
+    radio.syncWord(0x00, 0x00);
+    radio.cfgAFC(80);
+    radio.cfgCRC(0);
+    radio.cfgBasicPreamble();
+    radio.cfgPB(0x080, 0x000);
+    radio.PHY_RDY();
+    radio.cfgIRQ(0x00, irqSources);
+    bus.beginTransaction(ADF7242_SPI_DATA_CLOCK, MSBFIRST, ADF7242_SPI_MODE);
+  }
+
+  // Bring the board's modeled time up to nowNs
+  void catchUp(uint64_t nowNs) {
+    if (bus.nowNs() < nowNs) {
+      bus.advance(nowNs - bus.nowNs());
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Two boards on one lossy channel, stepped in lockstep. The transmitter
+// sends the next batch as soon as IRQ_TX_PKT_SENT reports the last one
+// gone; the receiver services IRQ1 as the RX sketch does and decodes each
+// frame. Latency runs from writePacket() on the transmitter to the end of
+// the decode on the receiver.
+////////////////////////////////////////////////////////////////////////////
+static void runLink() {
+  ADF7242Link link(1);
+  Node tx(RADIO_CS, RADIO_IRQ);
+  Node rx(RADIO_CS, RADIO_IRQ);
+  link.attach(tx.sim);
+  link.attach(rx.sim);
+  link.setLoss(LINK_LOSS);
+  link.setCorruption(LINK_CORRUPTION);
+  link.setDelay(LINK_DELAY_NS);
+  tx.bringUp(IRQ_TX_PKT_SENT);
+  rx.bringUp(IRQ_RX_PKT_RCVD);
+  rx.radio.receive();
+
+  uint64_t start = tx.bus.nowNs() > rx.bus.nowNs() ? tx.bus.nowNs() : rx.bus.nowNs();
+  tx.catchUp(start);
+  rx.catchUp(start);
+  link.clearStats();
+
+  std::vector<uint64_t> sentAt(LINK_PACKETS);
+  TelemetryBatch batch(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), LINK_SAMPLES_PER_PACKET, 0xFFFFFFFF,
+                       ADF7242_MAX_PAYLOAD + 1);
+  uint8_t frame[ADF7242_MAX_PAYLOAD + 1];
+  unsigned long sent = 0;
+  bool txBusy = false;
+  unsigned long good = 0;
+  unsigned long frameErrors = 0;
+  uint64_t usefulBytes = 0;
+  uint64_t latencySum = 0;
+  uint64_t latencyMax = 0;
+  uint64_t lastActivity = start;
+  uint64_t now = start;
+
+  while (sent < LINK_PACKETS || now < lastActivity + 50000000ULL) {
+    now += LINK_STEP_NS;
+    tx.catchUp(now);
+    rx.catchUp(now);
+
+    if (txBusy && tx.bus.digitalRead(RADIO_IRQ) == HIGH) {
+      tx.radio.clearIRQ();
+      txBusy = false;
+    }
+    if (!txBusy && sent < LINK_PACKETS) {
+      for (int i = 0; i < LINK_SAMPLES_PER_PACKET; ++i) {
+        TelemetryTimedAttitude record = {(uint32_t)(sent * LINK_SAMPLES_PER_PACKET + i), 1, 2, 3};
+        batch.add(&record, 0);
+      }
+      size_t len = batch.encode((uint16_t)sent, frame, sizeof(frame));
+      sentAt[sent++] = tx.bus.nowNs();
+      tx.radio.writePacket(frame, len - 1);
+      tx.radio.transmit();
+      txBusy = true;
+      lastActivity = tx.bus.nowNs();
+    }
+
+    if (rx.bus.digitalRead(RADIO_IRQ) == HIGH) {
+      uint8_t rxPayload[ADF7242_MAX_PAYLOAD];
+      int len = rx.radio.serviceIRQ(rxPayload, sizeof(rxPayload));
+      TelemetryFrame rxFrame;
+      if (len > 0 && telemetryDecode(rxPayload, len, rxFrame) == TELEMETRY_OK && rxFrame.seq < sent) {
+        uint64_t latency = rx.bus.nowNs() - sentAt[rxFrame.seq];
+        latencySum += latency;
+        latencyMax = latency > latencyMax ? latency : latencyMax;
+        usefulBytes += rxFrame.length - TELEMETRY_BATCH_HEADER;
+        ++good;
+      } else if (len > 0) {
+        ++frameErrors;
+      }
+      lastActivity = rx.bus.nowNs();
+    }
+  }
+
+  ADF7242LinkStats s = link.stats();
+  double elapsed = (double)(lastActivity - start);
+  printf("  \"link\": {\"packets\": %lu, \"data_rate_bps\": %u, \"loss\": %.3f, \"corruption\": %.3f, "
+         "\"lost\": %lu, \"corrupted\": %lu, \"received\": %lu, \"missed\": %lu, \"good_frames\": %lu, "
+         "\"frame_errors\": %lu, \"goodput_bps\": %.0f, \"air_utilization\": %.3f, "
+         "\"latency_us_mean\": %.1f, \"latency_us_max\": %.1f},\n",
+         sent, rx.sim.dataRate(), LINK_LOSS, LINK_CORRUPTION, s.lost, s.corrupted, rx.sim.received(), rx.sim.missed(),
+         good, frameErrors, usefulBytes * 8e9 / elapsed, s.airNs / elapsed,
+         good ? latencySum / 1000.0 / good : 0.0, latencyMax / 1000.0);
+}
+
+// Counts the samples handed over by TelemetryIngest
+static void countSamples(const TelemetrySpan &span, void* arg) {
+  *(uint64_t*)arg += span.count;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Writes a pre-encoded sample stream into the master side of a pseudo-
+// terminal from a second thread while TelemetryIngest reads the raw slave
+// side, and reports what the reader sustained on one core
+////////////////////////////////////////////////////////////////////////////
+static void runIngest() {
+  std::vector<uint8_t> stream;
+  uint8_t frame[TELEMETRY_ENCODED_SIZE(sizeof(ADIS16480Sample))];
+  ADIS16480Sample sample;
+  memset(&sample, 0, sizeof(sample));
+  for (unsigned long i = 0; i < INGEST_FRAMES; ++i) {
+    sample.timestamp = i * 407;
+    sample.seqCnt = (uint16_t)i;
+    sample.gyro[0] = (int32_t)(i * 1234567);
+    size_t len = telemetryEncode(TELEM_SAMPLE, (uint16_t)i, (const uint8_t*)&sample, sizeof(sample), frame, sizeof(frame));
+    stream.insert(stream.end(), frame, frame + len);
+    if (i % INGEST_NOISE_EVERY == INGEST_NOISE_EVERY - 1) {
+      static const uint8_t noise[] = {0x55, 0xAA, 0x13};
+      stream.insert(stream.end(), noise, noise + sizeof(noise)); // Garbles the start of the next frame
+    }
+  }
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    printf("  \"ingest\": null,\n");
+    return;
+  }
+  TelemetryIngest ingest;
+  uint64_t samples = 0;
+  if (!ingest.open(ptsname(master))) {
+    printf("  \"ingest\": null,\n");
+    close(master);
+    return;
+  }
+  ingest.subscribe(TELEM_SAMPLE, countSamples, &samples);
+
+  std::thread writer([&]() {
+    size_t pos = 0;
+    while (pos < stream.size()) {
+      ssize_t n = write(master, &stream[pos], stream.size() - pos < 4096 ? stream.size() - pos : 4096);
+      if (n <= 0) {
+        break;
+      }
+      pos += n;
+    }
+  });
+  while (ingest.stats().bytes < stream.size() && ingest.poll(1000) > 0) {
+  }
+  writer.join();
+  TelemetryIngestStats s = ingest.stats();
+  close(master);
+
+  printf("  \"ingest\": {\"bytes\": %llu, \"frames\": %llu, \"samples\": %llu, \"resyncs\": %llu, \"lost\": %llu, "
+         "\"bytes_per_s\": %.0f, \"frames_per_s\": %.0f, \"mbit_per_s\": %.1f},\n",
+         (unsigned long long)s.bytes, (unsigned long long)s.frames, (unsigned long long)samples,
+         (unsigned long long)s.resyncs, (unsigned long long)s.lost, s.bytesPerSecond(), s.framesPerSecond(),
+         s.bytesPerSecond() * 8e-6);
+}
+
+// Slowly varying sample i of a synthetic session at DEC_RATE 9, with micros() wrapping part way
+static void logSample(unsigned long i, ADIS16480Sample &s) {
+  memset(&s, 0, sizeof(s));
+  s.timestamp = 0xF0000000UL + (uint32_t)(i * 4065ULL);
+  s.seqCnt = (uint16_t)i;
+  s.temp = (int16_t)(1200 + i / 50000);
+  for (int a = 0; a < 3; ++a) {
+    s.gyro[a] = (int32_t)((i * (a + 3)) % 65536 * 97) - 3178496;
+    s.accl[a] = (a == 2 ? 50000000 : 0) + (int32_t)(i % 1000) * (a + 1);
+    s.magn[a] = (int16_t)(2000 - a * 300);
+    s.deltAng[a] = s.gyro[a] / 246;
+    s.deltVel[a] = s.accl[a] / 246;
+    s.euler[a] = (int16_t)(i * (a + 1));
+  }
+  s.barom = 101325 * 1000 + (int32_t)(i % 300);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Records LOG_ROWS samples, then times mapping the log and reading random
+// LOG_WINDOW_US windows, then checks rows read back against the original
+////////////////////////////////////////////////////////////////////////////
+static void runLog() {
+  char path[] = "/tmp/benchlogXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    printf("  \"log\": null,\n");
+    return;
+  }
+  close(fd);
+
+  ADIS16480Sample s;
+  SampleLogWriter writer;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  bool ok = writer.open(path);
+  for (unsigned long i = 0; i < LOG_ROWS && ok; ++i) {
+    logSample(i, s);
+    ok = writer.append(s);
+  }
+  ok = writer.close() && ok;
+  double writeNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+
+  SampleLogReader reader;
+  start = std::chrono::steady_clock::now();
+  ok = reader.open(path) && ok;
+  double openNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  if (!ok) {
+    unlink(path);
+    printf("  \"log\": null,\n");
+    return;
+  }
+
+  std::vector<SampleLogRecord> rows;
+  unsigned long returned = 0;
+  unsigned long mismatches = 0;
+  uint64_t first = 0xF0000000ULL;
+  uint64_t span = (uint64_t)(LOG_ROWS - 1) * 4065;
+  uint32_t rng = 2463534242UL;
+  start = std::chrono::steady_clock::now();
+  for (int q = 0; q < LOG_QUERIES; ++q) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    uint64_t t0 = first + (uint64_t)rng % span;
+    rows.clear();
+    returned += reader.read(t0, t0 + LOG_WINDOW_US, rows);
+  }
+  double queryNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    unsigned long i = (unsigned long)((rows[r].time - first) / 4065);
+    logSample(i, s);
+    mismatches += memcmp(&s, &rows[r].sample, sizeof(s)) != 0;
+  }
+  size_t step = reader.chunks() / 7 ? reader.chunks() / 7 : 1; // Small logs are checked chunk by chunk
+  for (size_t c = 0; c < reader.chunks(); c += step) {
+    rows.clear();
+    reader.read(c, rows);
+    for (size_t r = 0; r < rows.size(); ++r) {
+      logSample(reader.chunk(c).firstRow + r, s);
+      mismatches += memcmp(&s, &rows[r].sample, sizeof(s)) != 0;
+    }
+  }
+
+  double raw = (double)LOG_ROWS * sizeof(ADIS16480Sample);
+  printf("  \"log\": {\"rows\": %llu, \"chunks\": %lu, \"file_bytes\": %llu, \"compression\": %.2f, "
+         "\"write_mb_per_s\": %.1f, \"open_us\": %.1f, \"window_us\": %u, \"query_us_mean\": %.1f, "
+         "\"rows_per_query\": %.1f, \"mismatches\": %lu},\n",
+         (unsigned long long)reader.rows(), (unsigned long)reader.chunks(), (unsigned long long)writer.bytes(),
+         raw / writer.bytes(), raw / writeNs * 1e3, openNs / 1000.0, LOG_WINDOW_US, queryNs / 1000.0 / LOG_QUERIES,
+         (double)returned / LOG_QUERIES, mismatches);
+  reader.close();
+  unlink(path);
+}
+
+// Double precision quaternion, the reference for the Q30 one
+struct QuatRef {
+  double w, x, y, z;
+};
+
+static QuatRef refMultiply(const QuatRef &a, const QuatRef &b) {
+  QuatRef r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+               a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+               a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+               a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+  return(r);
+}
+
+// Exact rotation of one sample's delta angles
+static QuatRef refDelta(const int32_t deltAng[3]) {
+  double v[3];
+  for (int i = 0; i < 3; ++i) {
+    v[i] = deltAng[i] * ADIS16480_DELTANG_SCALE_D * M_PI / 180.0;
+  }
+  double angle = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  double k = angle > 0 ? sin(angle / 2) / angle : 0.5;
+  QuatRef r = {cos(angle / 2), v[0] * k, v[1] * k, v[2] * k};
+  return(r);
+}
+
+// Z-Y-X Euler angles in degrees
+static void refEuler(const QuatRef &q, double euler[3]) {
+  euler[0] = atan2(2 * (q.w * q.x + q.y * q.z), 1 - 2 * (q.x * q.x + q.y * q.y)) * 180 / M_PI;
+  double s = 2 * (q.w * q.y - q.x * q.z);
+  euler[1] = asin(s > 1 ? 1 : (s < -1 ? -1 : s)) * 180 / M_PI;
+  euler[2] = atan2(2 * (q.w * q.z + q.x * q.y), 1 - 2 * (q.y * q.y + q.z * q.z)) * 180 / M_PI;
+}
+
+// Smallest difference of two angles in degrees
+static double angleDiff(double a, double b) {
+  double d = fmod(a - b + 540.0, 360.0) - 180.0;
+  return(fabs(d));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Feeds QUAT_UPDATES samples of quantized delta angles from a tumbling
+// motion (rates up to about 300 deg/s on every axis) to quatIntegrate()
+// and to a double precision integration of the same samples, and reports
+// the attitude and Euler errors and the host cost per call. On the Teensy
+// the "integrateAttitude" profile probe of the TX sketch gives cycles.
+////////////////////////////////////////////////////////////////////////////
+static void runQuaternion() {
+  std::vector<int32_t> deltas((size_t)QUAT_UPDATES * 3);
+  double dt = 1.0 / QUAT_RATE_HZ;
+  for (unsigned long i = 0; i < QUAT_UPDATES; ++i) {
+    double t = (i + 0.5) * dt;
+    double rate[3] = {200 * sin(2 * M_PI * 0.31 * t) + 40, 150 * cos(2 * M_PI * 0.17 * t + 1), 90 * sin(2 * M_PI * 0.05 * t) + 25};
+    for (int a = 0; a < 3; ++a) {
+      deltas[i * 3 + a] = (int32_t)lround(rate[a] * dt / ADIS16480_DELTANG_SCALE_D);
+    }
+  }
+
+  Quaternion q;
+  QuatRef ref = {1, 0, 0, 0};
+  quatIdentity(q);
+  double maxError = 0;
+  double maxNormError = 0;
+  double maxEulerLsb = 0;
+  int16_t euler[3];
+  double refAngles[3];
+  double error = 0;
+  for (unsigned long i = 0; i < QUAT_UPDATES; ++i) {
+    quatIntegrate(q, &deltas[i * 3]);
+    ref = refMultiply(ref, refDelta(&deltas[i * 3]));
+    double n = sqrt(ref.w * ref.w + ref.x * ref.x + ref.y * ref.y + ref.z * ref.z);
+    ref.w /= n;
+    ref.x /= n;
+    ref.y /= n;
+    ref.z /= n;
+    double w = q.w / (double)QUAT_ONE, x = q.x / (double)QUAT_ONE, y = q.y / (double)QUAT_ONE, z = q.z / (double)QUAT_ONE;
+    double dot = fabs(w * ref.w + x * ref.x + y * ref.y + z * ref.z);
+    double norm = sqrt(w * w + x * x + y * y + z * z);
+    error = 2 * acos(dot / norm > 1 ? 1 : dot / norm) * 180 / M_PI;
+    maxError = error > maxError ? error : maxError;
+    maxNormError = fabs(norm - 1) > maxNormError ? fabs(norm - 1) : maxNormError;
+
+    quatToEuler(q, euler);
+    refEuler(ref, refAngles);
+    for (int a = 0; a < 3; ++a) {
+      if (a != 1 && fabs(refAngles[1]) > 85) {
+        continue; // Roll and yaw are ill defined near gimbal lock
+      }
+      double lsb = angleDiff(euler[a] * ADIS16480_EULER_SCALE, refAngles[a]) / ADIS16480_EULER_SCALE;
+      maxEulerLsb = lsb > maxEulerLsb ? lsb : maxEulerLsb;
+    }
+  }
+  double finalError = error; // After the last update
+
+  // Euler round trip through quatFromEuler()
+  double maxRoundTripLsb = 0;
+  for (int r = -32768; r < 32768; r += 997) {
+    for (int p = -16000; p <= 16000; p += 1231) {
+      int16_t in[3] = {(int16_t)r, (int16_t)p, (int16_t)(r * 3 + 12345)};
+      Quaternion e;
+      quatFromEuler(in, e);
+      quatToEuler(e, euler);
+      for (int a = 0; a < 3; ++a) {
+        double lsb = fabs((double)(int16_t)(euler[a] - in[a]));
+        maxRoundTripLsb = lsb > maxRoundTripLsb ? lsb : maxRoundTripLsb;
+      }
+    }
+  }
+
+  quatIdentity(q);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < QUAT_UPDATES; ++i) {
+    quatIntegrate(q, &deltas[i * 3]);
+  }
+  double integrateNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  int32_t sink = 0;
+  start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < QUAT_UPDATES / 16; ++i) {
+    q.x ^= (int32_t)(i & 1); // Keep the call from being hoisted
+    quatToEuler(q, euler);
+    sink += euler[0] + euler[1] + euler[2];
+  }
+  double eulerNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+
+  printf("  \"quaternion\": {\"updates\": %lu, \"rate_hz\": %.0f, \"attitude_error_deg_max\": %.6f, "
+         "\"attitude_error_deg_final\": %.6f, \"norm_error_max\": %.2e, \"euler_error_lsb_max\": %.2f, "
+         "\"euler_round_trip_lsb_max\": %.0f, \"integrate_ns\": %.1f, \"to_euler_ns\": %.1f, \"sink\": %d},\n",
+         (unsigned long)QUAT_UPDATES, QUAT_RATE_HZ, maxError, finalError, maxNormError, maxEulerLsb, maxRoundTripLsb,
+         integrateNs / QUAT_UPDATES, eulerNs / (QUAT_UPDATES / 16), (int)(sink & 1));
+}
+
+int main(int argc, char** argv) {
+  unsigned long iterations = (argc > 1) ? strtoul(argv[1], 0, 0) : 10000;
+  if (iterations == 0) {
+    fprintf(stderr, "usage: bench [iterations]\n");
+    return(1);
+  }
+  for (int i = 0; i < ADF7242_MAX_PAYLOAD; ++i) {
+    payload[i] = (uint8_t)(i * 37 + 11);
+  }
+
+  size_t count = sizeof(benches) / sizeof(benches[0]);
+  printf("{\n  \"units\": {\"frames\": \"per op\", \"bytes\": \"per op\", \"bus_us\": \"modeled per op\", "
+         "\"busy_us\": \"modeled per op\", \"stall_us\": \"modeled per op\", \"cpu_ns\": \"host per op\"},\n");
+  runLink();
+  runIngest();
+  runLog();
+  runQuaternion();
+  printf("  \"benchmarks\": [\n");
+  for (size_t i = 0; i < count; ++i) {
+    run(benches[i], iterations, i + 1 == count);
+  }
+  printf("  ]\n}\n");
+  return(0);
+}
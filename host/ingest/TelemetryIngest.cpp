@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host library, standard C++11 and POSIX
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TelemetryIngest.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TelemetryIngest.h"
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static uint64_t nowNs() {
+  return((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+////////////////////////////////////////////////////////////////////////////
+// chunk - bytes requested per read(). The buffer also holds one unfinished
+//         frame carried over from the previous chunk.
+////////////////////////////////////////////////////////////////////////////
+TelemetryIngest::TelemetryIngest(size_t chunk)
+  : _buf(chunk + TELEMETRY_MAX_ENCODED), _chunk(chunk), _fill(0), _skipping(false), _fd(-1), _owned(false) {
+  clearStats();
+}
+
+TelemetryIngest::~TelemetryIngest() {
+  close();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool open(const char* path)
+////////////////////////////////////////////////////////////////////////////
+// Opens the source read only. A tty is put in raw mode so no byte is
+// translated or held back by the line discipline.
+////////////////////////////////////////////////////////////////////////////
+// path - file, named pipe, tty (/dev/ttyACM0, a pty slave), or "-" for stdin
+// return - false if the source cannot be opened, errno tells why
+////////////////////////////////////////////////////////////////////////////
+bool TelemetryIngest::open(const char* path) {
+  if (strcmp(path, "-") == 0) {
+    attach(STDIN_FILENO);
+    return(true);
+  }
+  int fd = ::open(path, O_RDONLY | O_NOCTTY);
+  if (fd < 0) {
+    return(false);
+  }
+  struct termios tio;
+  if (isatty(fd) && tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  attach(fd, true);
+  return(true);
+}
+
+void TelemetryIngest::attach(int fd, bool owned) {
+  close();
+  _fd = fd;
+  _owned = owned;
+  _fill = 0;
+  _skipping = false;
+  clearStats();
+}
+
+void TelemetryIngest::close() {
+  if (_fd >= 0 && _owned) {
+    ::close(_fd);
+  }
+  _fd = -1;
+  _owned = false;
+}
+
+void TelemetryIngest::subscribe(uint8_t type, TelemetryHandler handler, void* arg) {
+  Subscriber s = {type, handler, arg};
+  _subscribers.push_back(s);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// long poll(int timeoutMs)
+////////////////////////////////////////////////////////////////////////////
+// Reads whatever the source has, up to one chunk, straight in behind the
+// unfinished frame left by the last call, then dispatches every frame the
+// chunk completes.
+////////////////////////////////////////////////////////////////////////////
+// timeoutMs - longest wait for data [ms], -1 to block
+// return - bytes read, 0 at end of file, -1 on error or timeout (errno
+//          EAGAIN)
+////////////////////////////////////////////////////////////////////////////
+long TelemetryIngest::poll(int timeoutMs) {
+  struct pollfd p = {_fd, POLLIN, 0};
+  int ready = ::poll(&p, 1, timeoutMs);
+  if (ready == 0) {
+    errno = EAGAIN;
+    return(-1);
+  }
+  if (ready < 0) {
+    return(-1);
+  }
+  ssize_t n = ::read(_fd, &_buf[_fill], _chunk);
+  if (n <= 0) {
+    return(n == 0 ? 0 : -1);
+  }
+  if (!_started) {
+    _startNs = nowNs();
+    _started = true;
+  }
+  _stats.bytes += n;
+  _fill += n;
+  parse();
+  return(n);
+}
+
+bool TelemetryIngest::run() {
+  long n;
+  while ((n = poll()) != 0) {
+    if (n < 0 && errno != EINTR) {
+      return(false);
+    }
+  }
+  return(true);
+}
+
+void TelemetryIngest::feed(const uint8_t* data, size_t len) {
+  if (!_started) {
+    _startNs = nowNs();
+    _started = true;
+  }
+  while (len > 0) {
+    size_t n = (len < _chunk) ? len : _chunk;
+    memcpy(&_buf[_fill], data, n);
+    _stats.bytes += n;
+    _fill += n;
+    parse();
+    data += n;
+    len -= n;
+  }
+}
+
+TelemetryIngestStats TelemetryIngest::stats() const {
+  TelemetryIngestStats s = _stats;
+  s.seconds = _started ? (nowNs() - _startNs) * 1e-9 : 0;
+  return(s);
+}
+
+void TelemetryIngest::clearStats() {
+  memset(&_stats, 0, sizeof(_stats));
+  _lastSeq = 0;
+  _seqValid = false;
+  _started = false;
+  _startNs = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Splits the buffer on 0x00 delimiters. A run longer than the largest
+// legal frame is noise: it is dropped up to the next delimiter, across
+// reads if need be. The unfinished frame at the end moves to the front.
+////////////////////////////////////////////////////////////////////////////
+void TelemetryIngest::parse() {
+  uint8_t* buf = &_buf[0];
+  size_t pos = 0;
+  while (pos < _fill) {
+    uint8_t* end = (uint8_t*)memchr(buf + pos, 0x00, _fill - pos);
+    if (!end) {
+      break;
+    }
+    size_t len = end - (buf + pos);
+    if (_skipping) {
+      _skipping = false;
+    } else if (len >= TELEMETRY_MAX_ENCODED) {
+      ++_stats.overlong;
+      ++_stats.resyncs;
+    } else if (len > 0) {
+      dispatch(buf + pos, len);
+    }
+    pos += len + 1;
+  }
+
+  size_t tail = _fill - pos;
+  if (_skipping) {
+    tail = 0;
+  } else if (tail >= TELEMETRY_MAX_ENCODED) {
+    ++_stats.overlong;
+    ++_stats.resyncs;
+    _skipping = true;
+    tail = 0;
+  }
+  if (tail > 0 && pos > 0) {
+    memmove(buf, buf + pos, tail);
+  }
+  _fill = tail;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Decodes one frame in place. A rejected frame is counted by reason and as
+// a resync; a good one updates the sequence gap count and its records go
+// to every subscriber of their type.
+////////////////////////////////////////////////////////////////////////////
+void TelemetryIngest::dispatch(uint8_t* frame, size_t len) {
+  TelemetryFrame f;
+  TelemetryStatus status = telemetryDecode(frame, len, f);
+  if (status != TELEMETRY_OK) {
+    ++_stats.bad[status];
+    ++_stats.resyncs;
+    return;
+  }
+  ++_stats.frames;
+  uint16_t gap = (uint16_t)(f.seq - _lastSeq - 1);
+  if (_seqValid && gap < 0x8000) { // A backwards jump means the transmitter restarted
+    _stats.lost += gap;
+  }
+  _lastSeq = f.seq;
+  _seqValid = true;
+
+  TelemetrySpan span;
+  span.seq = f.seq;
+  if (f.type == TELEM_BATCH) {
+    span.count = telemetryBatchRecords(f, span.type, span.size, span.data);
+    if (span.count == 0) {
+      return;
+    }
+  } else {
+    span.type = f.type;
+    span.size = f.length;
+    span.count = 1;
+    span.data = f.payload;
+  }
+  _stats.records += span.count;
+  for (size_t i = 0; i < _subscribers.size(); ++i) {
+    if (_subscribers[i].type == TELEMETRY_ANY || _subscribers[i].type == span.type) {
+      _subscribers[i].handler(span, _subscribers[i].arg);
+    }
+  }
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host library, standard C++11 and POSIX
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TelemetryIngest.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Native reader for the framed telemetry stream (see Telemetry.h) coming from a tty, pipe, or file.
+//  Bytes are read in large chunks into one buffer, split on the 0x00 delimiter, and decoded in place;
+//  subscribers get the records of every good frame as a span pointing into that buffer, so nothing
+//  is copied between the read() and the handler. Only the unfinished frame at the end of a chunk is
+//  moved to the front of the buffer before the next read.
+//
+//  After noise or a dropped byte the parser discards everything up to the next delimiter and counts
+//  a resync. Throughput, frame, and error counters are kept for the whole session.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TelemetryIngest_h
+#define TelemetryIngest_h
+
+#include <Telemetry.h>
+#include <vector>
+
+#define TELEMETRY_INGEST_CHUNK 65536 // Default read size [bytes]
+#define TELEMETRY_ANY 0x00 // Subscribe to every record type
+
+// Records of one frame: a single payload (count 1) or every record of a TELEM_BATCH frame.
+// data points into the ingest buffer and is valid only during the handler call.
+struct TelemetrySpan {
+  uint16_t seq; // Frame sequence number
+  uint8_t type; // TELEM_* type of each record
+  uint8_t size; // Bytes per record
+  uint8_t count; // Records in data
+  const uint8_t* data;
+};
+
+typedef void (*TelemetryHandler)(const TelemetrySpan &span, void* arg);
+
+// Session counters
+struct TelemetryIngestStats {
+  uint64_t bytes; // Bytes read from the source
+  uint64_t frames; // Frames that decoded
+  uint64_t records; // Records handed to subscribers
+  uint64_t bad[TELEMETRY_BAD_VERSION + 1]; // Rejected frames by TelemetryStatus
+  uint64_t overlong; // Runs longer than any legal frame
+  uint64_t resyncs; // Times the parser skipped to the next delimiter
+  uint64_t lost; // Frames missing from the sequence numbers
+  double seconds; // Time since the first byte arrived
+
+  double bytesPerSecond() const { return(seconds > 0 ? bytes / seconds : 0); }
+  double framesPerSecond() const { return(seconds > 0 ? frames / seconds : 0); }
+};
+
+// TelemetryIngest class definition
+class TelemetryIngest {
+public:
+  TelemetryIngest(size_t chunk = TELEMETRY_INGEST_CHUNK);
+  ~TelemetryIngest();
+
+  // Read from a file, pipe, or tty (switched to raw mode), or stdin for "-". Returns false if it cannot be opened.
+  bool open(const char* path);
+
+  // Read from an already open descriptor, closed by close() only if owned
+  void attach(int fd, bool owned = false);
+  void close();
+
+  // Call handler with the records of every good frame of the given type (TELEMETRY_ANY for all)
+  void subscribe(uint8_t type, TelemetryHandler handler, void* arg = 0);
+
+  // Wait up to timeoutMs (-1 forever) for data, read one chunk, and dispatch every complete frame.
+  // Returns the bytes read, 0 on end of file, -1 on error or timeout with errno set.
+  long poll(int timeoutMs = -1);
+
+  // Read until end of file. Returns false on a read error.
+  bool run();
+
+  // Parse bytes from any other source, as if they had been read
+  void feed(const uint8_t* data, size_t len);
+
+  // Counters since open() or clearStats()
+  TelemetryIngestStats stats() const;
+  void clearStats();
+
+private:
+  struct Subscriber {
+    uint8_t type;
+    TelemetryHandler handler;
+    void* arg;
+  };
+
+  // Decode and dispatch every delimited frame in _buf, keep the unfinished tail
+  void parse();
+
+  // Decode one frame in place and hand its records to the subscribers
+  void dispatch(uint8_t* frame, size_t len);
+
+  std::vector<uint8_t> _buf;
+  size_t _chunk;
+  size_t _fill; // Bytes held in _buf
+  bool _skipping; // Discarding an overlong run up to the next delimiter
+  int _fd;
+  bool _owned;
+  std::vector<Subscriber> _subscribers;
+  uint16_t _lastSeq;
+  bool _seqValid;
+  bool _started;
+  uint64_t _startNs;
+  TelemetryIngestStats _stats;
+};
+
+#endif
@@ -0,0 +1,526 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host library, standard C++11 and POSIX
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SampleLog.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SampleLog.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char headerMagic[8] = {'A', 'D', 'I', 'S', 'L', 'O', 'G', '1'};
+static const char trailerMagic[8] = {'A', 'D', 'I', 'S', 'L', 'O', 'G', 'E'};
+
+// Where each column lives in ADIS16480Sample
+struct SampleLogField {
+  uint8_t offset;
+  uint8_t size; // Bytes in the sample
+  bool isSigned;
+};
+
+static const SampleLogField fields[SAMPLELOG_COLUMNS] = {
+  {offsetof(ADIS16480Sample, timestamp), 4, false},
+  {offsetof(ADIS16480Sample, seqCnt), 2, false},
+  {offsetof(ADIS16480Sample, sysEFlag), 2, false},
+  {offsetof(ADIS16480Sample, temp), 2, true},
+  {offsetof(ADIS16480Sample, gyro), 4, true},
+  {offsetof(ADIS16480Sample, gyro) + 4, 4, true},
+  {offsetof(ADIS16480Sample, gyro) + 8, 4, true},
+  {offsetof(ADIS16480Sample, accl), 4, true},
+  {offsetof(ADIS16480Sample, accl) + 4, 4, true},
+  {offsetof(ADIS16480Sample, accl) + 8, 4, true},
+  {offsetof(ADIS16480Sample, magn), 2, true},
+  {offsetof(ADIS16480Sample, magn) + 2, 2, true},
+  {offsetof(ADIS16480Sample, magn) + 4, 2, true},
+  {offsetof(ADIS16480Sample, barom), 4, true},
+  {offsetof(ADIS16480Sample, deltAng), 4, true},
+  {offsetof(ADIS16480Sample, deltAng) + 4, 4, true},
+  {offsetof(ADIS16480Sample, deltAng) + 8, 4, true},
+  {offsetof(ADIS16480Sample, deltVel), 4, true},
+  {offsetof(ADIS16480Sample, deltVel) + 4, 4, true},
+  {offsetof(ADIS16480Sample, deltVel) + 8, 4, true},
+  {offsetof(ADIS16480Sample, euler), 2, true},
+  {offsetof(ADIS16480Sample, euler) + 2, 2, true},
+  {offsetof(ADIS16480Sample, euler) + 4, 2, true},
+};
+
+// Bytes per raw value in the file. Time is stored extended to 64 bits.
+static uint8_t storedWidth(int column) {
+  return(column == SAMPLELOG_TIME ? 8 : fields[column].size);
+}
+
+// Read one field of a sample, sign or zero extended
+static int64_t getField(const ADIS16480Sample &s, int column) {
+  const uint8_t* p = (const uint8_t*)&s + fields[column].offset;
+  if (fields[column].size == 2) {
+    uint16_t v;
+    memcpy(&v, p, 2);
+    return(fields[column].isSigned ? (int64_t)(int16_t)v : (int64_t)v);
+  }
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return(fields[column].isSigned ? (int64_t)(int32_t)v : (int64_t)v);
+}
+
+// Store one field of a sample, truncated to its size
+static void setField(ADIS16480Sample &s, int column, int64_t value) {
+  uint8_t* p = (uint8_t*)&s + fields[column].offset;
+  if (fields[column].size == 2) {
+    uint16_t v = (uint16_t)value;
+    memcpy(p, &v, 2);
+  } else {
+    uint32_t v = (uint32_t)value;
+    memcpy(p, &v, 4);
+  }
+}
+
+static size_t pad8(size_t n) {
+  return((n + 7) & ~(size_t)7);
+}
+
+// Append v as a zigzag varint
+static void putVarint(std::vector<uint8_t> &out, int64_t v) {
+  uint64_t z = ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+  while (z >= 0x80) {
+    out.push_back((uint8_t)(z | 0x80));
+    z >>= 7;
+  }
+  out.push_back((uint8_t)z);
+}
+
+// Read a zigzag varint, false past end
+static bool getVarint(const uint8_t* &p, const uint8_t* end, int64_t &v) {
+  uint64_t z = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (p >= end) {
+      return(false);
+    }
+    uint8_t b = *p++;
+    z |= (uint64_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      v = (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+      return(true);
+    }
+  }
+  return(false);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//                              Writer
+////////////////////////////////////////////////////////////////////////////
+
+SampleLogWriter::SampleLogWriter() : _file(0), _chunkRows(SAMPLELOG_CHUNK_ROWS), _compress(true), _ok(false),
+  _rows(0), _bytes(0), _lastStamp(0), _epoch(0) {
+}
+
+SampleLogWriter::~SampleLogWriter() {
+  close();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool open(const char* path, uint32_t chunkRows, bool compress)
+////////////////////////////////////////////////////////////////////////////
+// path - log file, replaced if it exists
+// chunkRows - rows per chunk, the granularity of a time seek
+// compress - delta encode columns where that is smaller than raw
+// return - false if the file cannot be created
+////////////////////////////////////////////////////////////////////////////
+bool SampleLogWriter::open(const char* path, uint32_t chunkRows, bool compress) {
+  close();
+  _file = fopen(path, "wb");
+  if (!_file) {
+    return(false);
+  }
+  _chunkRows = chunkRows ? chunkRows : SAMPLELOG_CHUNK_ROWS;
+  _compress = compress;
+  _ok = true;
+  _rows = 0;
+  _bytes = 0;
+  _lastStamp = 0;
+  _epoch = 0;
+  _index.clear();
+  for (int c = 0; c < SAMPLELOG_COLUMNS; ++c) {
+    _values[c].clear();
+    _values[c].reserve(_chunkRows);
+  }
+
+  SampleLogHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, headerMagic, sizeof(h.magic));
+  h.version = SAMPLELOG_VERSION;
+  h.columns = SAMPLELOG_COLUMNS;
+  h.chunkRows = _chunkRows;
+  h.sampleSize = sizeof(ADIS16480Sample);
+  _ok = fwrite(&h, sizeof(h), 1, _file) == 1;
+  _bytes = sizeof(h);
+  return(_ok);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Buffers one row. A timestamp below the previous one is either a micros()
+// wrap or a transmitter restart; both move the time axis on by 2^32 us, so
+// time keeps increasing across chunks and find() stays valid.
+////////////////////////////////////////////////////////////////////////////
+bool SampleLogWriter::append(const ADIS16480Sample &sample) {
+  if (!_file) {
+    return(false);
+  }
+  if (_rows > 0 && sample.timestamp < _lastStamp) {
+    _epoch += 0x100000000ULL;
+  }
+  _lastStamp = sample.timestamp;
+  _values[SAMPLELOG_TIME].push_back((int64_t)(_epoch + sample.timestamp));
+  for (int c = 1; c < SAMPLELOG_COLUMNS; ++c) {
+    _values[c].push_back(getField(sample, c));
+  }
+  ++_rows;
+  if (_values[0].size() >= _chunkRows) {
+    return(flushChunk());
+  }
+  return(_ok);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Encodes every column of the buffered rows, raw or delta, whichever is
+// smaller, and writes the chunk with its header and index entry
+////////////////////////////////////////////////////////////////////////////
+bool SampleLogWriter::flushChunk() {
+  uint32_t rows = (uint32_t)_values[0].size();
+  if (rows == 0 || !_ok) {
+    return(_ok);
+  }
+  SampleLogColumn cols[SAMPLELOG_COLUMNS];
+  std::vector<uint8_t> data[SAMPLELOG_COLUMNS];
+  for (int c = 0; c < SAMPLELOG_COLUMNS; ++c) {
+    const std::vector<int64_t> &v = _values[c];
+    SampleLogColumn &col = cols[c];
+    memset(&col, 0, sizeof(col));
+    col.width = storedWidth(c);
+    col.min = col.max = v[0];
+    for (uint32_t r = 1; r < rows; ++r) {
+      col.min = v[r] < col.min ? v[r] : col.min;
+      col.max = v[r] > col.max ? v[r] : col.max;
+    }
+    size_t rawBytes = (size_t)rows * col.width;
+    if (_compress) {
+      data[c].reserve(rawBytes);
+      putVarint(data[c], v[0]);
+      for (uint32_t r = 1; r < rows && data[c].size() < rawBytes; ++r) {
+        putVarint(data[c], v[r] - v[r - 1]);
+      }
+    }
+    if (_compress && data[c].size() < rawBytes) {
+      col.encoding = SAMPLELOG_DELTA;
+    } else {
+      col.encoding = SAMPLELOG_RAW;
+      data[c].resize(rawBytes);
+      for (uint32_t r = 0; r < rows; ++r) {
+        memcpy(&data[c][(size_t)r * col.width], &v[r], col.width); // Low bytes of a little endian int64
+      }
+    }
+    col.bytes = (uint32_t)data[c].size();
+  }
+
+  SampleLogChunk ch;
+  ch.magic = SAMPLELOG_CHUNK_MAGIC;
+  ch.rows = rows;
+  ch.firstRow = _rows - rows;
+  ch.minTime = (uint64_t)cols[SAMPLELOG_TIME].min;
+  ch.maxTime = (uint64_t)cols[SAMPLELOG_TIME].max;
+
+  SampleLogIndexEntry e;
+  memset(&e, 0, sizeof(e));
+  e.offset = _bytes;
+  e.firstRow = ch.firstRow;
+  e.minTime = ch.minTime;
+  e.maxTime = ch.maxTime;
+  e.rows = rows;
+  _index.push_back(e);
+
+  static const uint8_t zeros[8] = {0};
+  _ok = _ok && fwrite(&ch, sizeof(ch), 1, _file) == 1 && fwrite(cols, sizeof(cols), 1, _file) == 1;
+  _bytes += sizeof(ch) + sizeof(cols);
+  for (int c = 0; c < SAMPLELOG_COLUMNS && _ok; ++c) {
+    size_t padded = pad8(data[c].size());
+    _ok = fwrite(data[c].data(), 1, data[c].size(), _file) == data[c].size()
+      && fwrite(zeros, 1, padded - data[c].size(), _file) == padded - data[c].size();
+    _bytes += padded;
+  }
+  for (int c = 0; c < SAMPLELOG_COLUMNS; ++c) {
+    _values[c].clear();
+  }
+  return(_ok);
+}
+
+bool SampleLogWriter::close() {
+  if (!_file) {
+    return(_ok);
+  }
+  flushChunk();
+  SampleLogTrailer t;
+  memset(&t, 0, sizeof(t));
+  t.indexOffset = _bytes;
+  t.rows = _rows;
+  t.chunks = (uint32_t)_index.size();
+  memcpy(t.magic, trailerMagic, sizeof(t.magic));
+  if (_ok && !_index.empty()) {
+    _ok = fwrite(_index.data(), sizeof(SampleLogIndexEntry), _index.size(), _file) == _index.size();
+  }
+  _ok = _ok && fwrite(&t, sizeof(t), 1, _file) == 1;
+  _bytes += _index.size() * sizeof(SampleLogIndexEntry) + sizeof(t);
+  _ok = (fclose(_file) == 0) && _ok;
+  _file = 0;
+  return(_ok);
+}
+
+uint64_t SampleLogWriter::rows() const {
+  return(_rows);
+}
+
+uint64_t SampleLogWriter::bytes() const {
+  return(_bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//                              Reader
+////////////////////////////////////////////////////////////////////////////
+
+SampleLogReader::SampleLogReader() : _map(0), _size(0), _trailer(0), _index(0) {
+}
+
+SampleLogReader::~SampleLogReader() {
+  close();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool open(const char* path)
+////////////////////////////////////////////////////////////////////////////
+// Maps the whole file read only. Only the header, trailer, and index are
+// checked here; chunks are touched (and paged in) when they are read.
+////////////////////////////////////////////////////////////////////////////
+// path - log written by SampleLogWriter
+// return - false if the file is missing, truncated, or not a sample log
+////////////////////////////////////////////////////////////////////////////
+bool SampleLogReader::open(const char* path) {
+  close();
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return(false);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SampleLogHeader) + sizeof(SampleLogTrailer)) {
+    ::close(fd);
+    return(false);
+  }
+  void* map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return(false);
+  }
+  _map = (const uint8_t*)map;
+  _size = st.st_size;
+
+  const SampleLogHeader* h = (const SampleLogHeader*)_map;
+  _trailer = (const SampleLogTrailer*)(_map + _size - sizeof(SampleLogTrailer));
+  if (memcmp(h->magic, headerMagic, sizeof(headerMagic)) != 0 || h->version != SAMPLELOG_VERSION
+      || h->columns != SAMPLELOG_COLUMNS || memcmp(_trailer->magic, trailerMagic, sizeof(trailerMagic)) != 0
+      || _trailer->indexOffset + (uint64_t)_trailer->chunks * sizeof(SampleLogIndexEntry) + sizeof(SampleLogTrailer)
+         != _size) {
+    close();
+    return(false);
+  }
+  _index = (const SampleLogIndexEntry*)(_map + _trailer->indexOffset);
+  return(true);
+}
+
+void SampleLogReader::close() {
+  if (_map) {
+    munmap((void*)_map, _size);
+  }
+  _map = 0;
+  _size = 0;
+  _trailer = 0;
+  _index = 0;
+}
+
+uint64_t SampleLogReader::rows() const {
+  return(_trailer ? _trailer->rows : 0);
+}
+
+size_t SampleLogReader::chunks() const {
+  return(_trailer ? _trailer->chunks : 0);
+}
+
+const SampleLogIndexEntry &SampleLogReader::chunk(size_t i) const {
+  return(_index[i]);
+}
+
+bool SampleLogReader::range(size_t i, int column, int64_t &min, int64_t &max) const {
+  if (i >= chunks() || column < 0 || column >= SAMPLELOG_COLUMNS) {
+    return(false);
+  }
+  const SampleLogIndexEntry &e = _index[i];
+  if (e.offset + sizeof(SampleLogChunk) + SAMPLELOG_COLUMNS * sizeof(SampleLogColumn) > _trailer->indexOffset) {
+    return(false);
+  }
+  const SampleLogChunk* ch = (const SampleLogChunk*)(_map + e.offset);
+  if (ch->magic != SAMPLELOG_CHUNK_MAGIC) {
+    return(false);
+  }
+  const SampleLogColumn* cols = (const SampleLogColumn*)(ch + 1);
+  min = cols[column].min;
+  max = cols[column].max;
+  return(true);
+}
+
+size_t SampleLogReader::find(uint64_t timeUs) const {
+  size_t lo = 0;
+  size_t hi = chunks();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (_index[mid].maxTime < timeUs) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return(lo);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool column(size_t i, int column, int64_t* values)
+////////////////////////////////////////////////////////////////////////////
+// Decodes one column of one chunk. Other columns are skipped by their
+// sizes in the chunk header, so their data is never read.
+////////////////////////////////////////////////////////////////////////////
+// i - chunk number
+// column - SAMPLELOG_* column
+// values - receives chunk(i).rows values
+// return - false if the chunk is damaged
+////////////////////////////////////////////////////////////////////////////
+bool SampleLogReader::column(size_t i, int column, int64_t* values) const {
+  if (i >= chunks() || column < 0 || column >= SAMPLELOG_COLUMNS) {
+    return(false);
+  }
+  const SampleLogIndexEntry &e = _index[i];
+  size_t headerBytes = sizeof(SampleLogChunk) + SAMPLELOG_COLUMNS * sizeof(SampleLogColumn);
+  if (e.offset + headerBytes > _trailer->indexOffset) {
+    return(false);
+  }
+  const SampleLogChunk* ch = (const SampleLogChunk*)(_map + e.offset);
+  const SampleLogColumn* cols = (const SampleLogColumn*)(ch + 1);
+  if (ch->magic != SAMPLELOG_CHUNK_MAGIC || ch->rows != e.rows) {
+    return(false);
+  }
+  uint64_t offset = e.offset + headerBytes;
+  for (int c = 0; c < column; ++c) {
+    offset += pad8(cols[c].bytes);
+  }
+  const SampleLogColumn &col = cols[column];
+  if (offset + col.bytes > _trailer->indexOffset) {
+    return(false);
+  }
+  const uint8_t* p = _map + offset;
+  const uint8_t* end = p + col.bytes;
+
+  if (col.encoding == SAMPLELOG_RAW) {
+    if ((uint64_t)col.width * e.rows != col.bytes || col.width > 8) {
+      return(false);
+    }
+    bool isSigned = column != SAMPLELOG_TIME && fields[column].isSigned;
+    for (uint32_t r = 0; r < e.rows; ++r) {
+      uint64_t v = 0;
+      memcpy(&v, p + (size_t)r * col.width, col.width);
+      if (isSigned && col.width < 8 && (v >> (col.width * 8 - 1)) & 1) {
+        v |= ~0ULL << (col.width * 8); // Sign extend
+      }
+      values[r] = (int64_t)v;
+    }
+    return(true);
+  }
+  if (col.encoding == SAMPLELOG_DELTA) {
+    int64_t v = 0;
+    for (uint32_t r = 0; r < e.rows; ++r) {
+      int64_t d;
+      if (!getVarint(p, end, d)) {
+        return(false);
+      }
+      v = (r == 0) ? d : v + d;
+      values[r] = v;
+    }
+    return(true);
+  }
+  return(false);
+}
+
+bool SampleLogReader::read(size_t i, std::vector<SampleLogRecord> &out) const {
+  if (i >= chunks()) {
+    return(false);
+  }
+  uint32_t rows = _index[i].rows;
+  std::vector<int64_t> values((size_t)rows * SAMPLELOG_COLUMNS);
+  for (int c = 0; c < SAMPLELOG_COLUMNS; ++c) {
+    if (!column(i, c, &values[(size_t)c * rows])) {
+      return(false);
+    }
+  }
+  size_t first = out.size();
+  out.resize(first + rows);
+  for (uint32_t r = 0; r < rows; ++r) {
+    SampleLogRecord &rec = out[first + r];
+    memset(&rec, 0, sizeof(rec));
+    rec.time = (uint64_t)values[r];
+    rec.sample.timestamp = (uint32_t)rec.time;
+    for (int c = 1; c < SAMPLELOG_COLUMNS; ++c) {
+      setField(rec.sample, c, values[(size_t)c * rows + r]);
+    }
+  }
+  return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// size_t read(uint64_t t0, uint64_t t1, std::vector<SampleLogRecord> &out)
+////////////////////////////////////////////////////////////////////////////
+// Binary searches the index for the first chunk reaching t0 and decodes
+// chunks until one starts after t1. Only the chunks overlapping the range
+// are paged in.
+////////////////////////////////////////////////////////////////////////////
+size_t SampleLogReader::read(uint64_t t0, uint64_t t1, std::vector<SampleLogRecord> &out) const {
+  size_t before = out.size();
+  std::vector<SampleLogRecord> rows;
+  for (size_t i = find(t0); i < chunks() && _index[i].minTime <= t1; ++i) {
+    rows.clear();
+    if (!read(i, rows)) {
+      break;
+    }
+    for (size_t r = 0; r < rows.size(); ++r) {
+      if (rows[r].time >= t0 && rows[r].time <= t1) {
+        out.push_back(rows[r]);
+      }
+    }
+  }
+  return(out.size() - before);
+}
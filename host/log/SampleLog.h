@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host library, standard C++11 and POSIX
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SampleLog.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Chunked columnar log of ADIS16480Sample records for recorded sessions. Rows are grouped into
+//  chunks; inside a chunk each field is stored as its own column, either raw or delta encoded
+//  (zigzag varints), whichever is smaller. Every chunk header carries the row count, time range,
+//  and per-column min/max, and an index at the end of the file lists every chunk, so a reader maps
+//  the file and goes straight to a time range without touching the chunks before it.
+//
+//  Time is the sample timestamp extended to 64 bits across micros() wraps, so multi-hour captures
+//  keep one time axis. Any timestamp below the previous one starts a new 2^32 us epoch, whether
+//  micros() wrapped or the transmitter restarted, so time never runs backwards in the file and the
+//  low 32 bits still hold the original timestamp.
+//
+//  File layout (little endian):
+//
+//    SampleLogHeader
+//    chunk:  SampleLogChunk, SampleLogColumn x SAMPLELOG_COLUMNS, column data (each padded to 8 bytes)
+//    ...
+//    SampleLogIndexEntry x chunks
+//    SampleLogTrailer
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SampleLog_h
+#define SampleLog_h
+
+#include <ADIS16480.h>
+#include <stdio.h>
+#include <vector>
+
+#define SAMPLELOG_VERSION 1
+#define SAMPLELOG_CHUNK_ROWS 4096 // Default rows per chunk
+
+// Column encodings
+#define SAMPLELOG_RAW 0 // width bytes per row
+#define SAMPLELOG_DELTA 1 // First value, then zigzag varint differences
+
+// Columns, in file order
+enum SampleLogColumnId {
+  SAMPLELOG_TIME = 0, // Timestamp extended to 64 bits [us]
+  SAMPLELOG_SEQ_CNT,
+  SAMPLELOG_SYS_E_FLAG,
+  SAMPLELOG_TEMP,
+  SAMPLELOG_GYRO_X, SAMPLELOG_GYRO_Y, SAMPLELOG_GYRO_Z,
+  SAMPLELOG_ACCL_X, SAMPLELOG_ACCL_Y, SAMPLELOG_ACCL_Z,
+  SAMPLELOG_MAGN_X, SAMPLELOG_MAGN_Y, SAMPLELOG_MAGN_Z,
+  SAMPLELOG_BAROM,
+  SAMPLELOG_DELTANG_X, SAMPLELOG_DELTANG_Y, SAMPLELOG_DELTANG_Z,
+  SAMPLELOG_DELTVEL_X, SAMPLELOG_DELTVEL_Y, SAMPLELOG_DELTVEL_Z,
+  SAMPLELOG_ROLL, SAMPLELOG_PITCH, SAMPLELOG_YAW,
+  SAMPLELOG_COLUMNS
+};
+
+struct SampleLogHeader {
+  char magic[8]; // "ADISLOG1"
+  uint32_t version; // SAMPLELOG_VERSION
+  uint16_t columns; // SAMPLELOG_COLUMNS
+  uint16_t reserved;
+  uint32_t chunkRows; // Rows per full chunk
+  uint32_t sampleSize; // sizeof(ADIS16480Sample) when written
+};
+
+struct SampleLogColumn {
+  uint8_t encoding; // SAMPLELOG_RAW or SAMPLELOG_DELTA
+  uint8_t width; // Bytes per value when raw
+  uint16_t reserved;
+  uint32_t bytes; // Encoded size, before padding
+  int64_t min; // Smallest value in the chunk
+  int64_t max; // Largest value in the chunk
+};
+
+struct SampleLogChunk {
+  uint32_t magic; // SAMPLELOG_CHUNK_MAGIC
+  uint32_t rows;
+  uint64_t firstRow; // Row number of the first row in the file
+  uint64_t minTime; // [us]
+  uint64_t maxTime; // [us]
+};
+
+struct SampleLogIndexEntry {
+  uint64_t offset; // File offset of the SampleLogChunk
+  uint64_t firstRow;
+  uint64_t minTime;
+  uint64_t maxTime;
+  uint32_t rows;
+  uint32_t reserved;
+};
+
+struct SampleLogTrailer {
+  uint64_t indexOffset; // File offset of the first SampleLogIndexEntry
+  uint64_t rows; // Rows in the file
+  uint32_t chunks; // Index entries
+  uint32_t reserved;
+  char magic[8]; // "ADISLOGE"
+};
+
+#define SAMPLELOG_CHUNK_MAGIC 0x4B4E4843 // "CHNK"
+
+// One decoded row
+struct SampleLogRecord {
+  uint64_t time; // [us], extended past micros() wraps
+  ADIS16480Sample sample; // timestamp holds the original 32 bit value
+};
+
+// SampleLogWriter class definition
+class SampleLogWriter {
+public:
+  SampleLogWriter();
+  ~SampleLogWriter();
+
+  // Create path. compress enables delta encoding where it is smaller. Returns false if it cannot be created.
+  bool open(const char* path, uint32_t chunkRows = SAMPLELOG_CHUNK_ROWS, bool compress = true);
+
+  // Append one sample
+  bool append(const ADIS16480Sample &sample);
+
+  // Write the last partial chunk, the index, and the trailer. Returns false on a write error.
+  bool close();
+
+  // Rows appended and bytes written so far
+  uint64_t rows() const;
+  uint64_t bytes() const;
+
+private:
+  // Encode and write the buffered rows as one chunk
+  bool flushChunk();
+
+  FILE* _file;
+  uint32_t _chunkRows;
+  bool _compress;
+  bool _ok;
+  uint64_t _rows;
+  uint64_t _bytes;
+  uint32_t _lastStamp; // Previous 32 bit timestamp
+  uint64_t _epoch; // Added to the 32 bit timestamp, grows by 2^32 each time the timestamp goes backwards
+  std::vector<int64_t> _values[SAMPLELOG_COLUMNS]; // Buffered chunk, one vector per column
+  std::vector<SampleLogIndexEntry> _index;
+};
+
+// SampleLogReader class definition
+class SampleLogReader {
+public:
+  SampleLogReader();
+  ~SampleLogReader();
+
+  // Map path and check its header, index, and trailer. Returns false if it is not a complete log.
+  bool open(const char* path);
+  void close();
+
+  // Rows and chunks in the file
+  uint64_t rows() const;
+  size_t chunks() const;
+
+  // Index entry of chunk i
+  const SampleLogIndexEntry &chunk(size_t i) const;
+
+  // Min/max of one column in chunk i, from the chunk header only. Returns false if the chunk is damaged.
+  bool range(size_t i, int column, int64_t &min, int64_t &max) const;
+
+  // First chunk whose time range reaches timeUs, chunks() if none (binary search of the index)
+  size_t find(uint64_t timeUs) const;
+
+  // Decode one column of chunk i into values (chunk(i).rows entries)
+  bool column(size_t i, int column, int64_t* values) const;
+
+  // Append every row of chunk i to out
+  bool read(size_t i, std::vector<SampleLogRecord> &out) const;
+
+  // Append every row with t0 <= time <= t1 to out. Returns the rows appended.
+  size_t read(uint64_t t0, uint64_t t1, std::vector<SampleLogRecord> &out) const;
+
+private:
+  const uint8_t* _map;
+  size_t _size;
+  const SampleLogTrailer* _trailer;
+  const SampleLogIndexEntry* _index;
+};
+
+#endif
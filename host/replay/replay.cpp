@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  replay.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Replays a recorded session through the firmware's serial framing: samples are read from a raw
+//  frame capture (teledump input) or a SampleLog, encoded again as TELEM_SAMPLE frames, or with -b
+//  as TELEM_BATCH frames of TELEM_TIMED_ATTITUDE records sized for one radio packet, the way the
+//  radio carries them to the RX board (its relaySample() path), and written to a pipe, file, or a new
+//  pseudo-terminal. Frames leave at the original inter-sample timing scaled by the speed factor,
+//  or as fast as the consumer takes them.
+//
+//  The output is non-blocking; time spent waiting for the consumer to drain it is reported as
+//  backpressure, and lag is how far the writer fell behind the schedule. Report goes to stderr.
+//
+//  Build:  cmake -S host -B build && cmake --build build   (see host/CMakeLists.txt)
+//  Usage:  replay [-s speed|max] [-b records] [-w seconds] capture.bin|session.adl [pipe|file|pty|-]
+//          (stdout when the output is omitted, real time when -s is omitted)
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <TelemetryIngest.h>
+#include <SampleLog.h>
+#include <ADIS16480.h>
+#include <ADF7242.h>
+#include <chrono>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define REPLAY_RADIO_ENCODED (ADF7242_MAX_PAYLOAD + 1) // A radio frame plus the 0x00 delimiter that is not sent
+#define REPLAY_WRITE 65536 // Most bytes gathered into one write()
+#define REPLAY_EARLY_US 200 // Frames due this soon go out with the current write [us]
+
+// Session to replay, times relative to the first sample [us]
+struct Session {
+  std::vector<ADIS16480Sample> samples;
+  std::vector<uint64_t> times;
+};
+
+// Output counters
+struct ReplayStats {
+  uint64_t frames;
+  uint64_t bytes;
+  uint64_t writes;
+  uint64_t stalls; // Writes the consumer was not ready for
+  double blockedSeconds; // Waiting for the consumer to drain the output
+  double maxLagMs; // Furthest behind schedule when a frame went out
+};
+
+// Appends one sample, unwrapping micros()
+static void addSample(Session &s, const ADIS16480Sample &sample) {
+  uint64_t t = 0;
+  if (!s.samples.empty()) {
+    int32_t step = (int32_t)(sample.timestamp - s.samples.back().timestamp);
+    t = s.times.back() + (step > 0 ? step : 0); // A transmitter restart replays with no gap
+  }
+  s.samples.push_back(sample);
+  s.times.push_back(t);
+}
+
+// Collects the samples of a raw capture, single or batched
+static void collectSpan(const TelemetrySpan &span, void* arg) {
+  Session* s = (Session*)arg;
+  if (span.size != sizeof(ADIS16480Sample)) {
+    return;
+  }
+  for (uint8_t i = 0; i < span.count; ++i) {
+    ADIS16480Sample sample;
+    memcpy(&sample, span.data + i * span.size, sizeof(sample));
+    addSample(*s, sample);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Loads a SampleLog, or failing that parses path as a raw frame capture
+////////////////////////////////////////////////////////////////////////////
+static bool loadSession(const char* path, Session &s) {
+  SampleLogReader log;
+  if (log.open(path)) {
+    std::vector<SampleLogRecord> rows;
+    s.samples.reserve(log.rows());
+    s.times.reserve(log.rows());
+    for (size_t i = 0; i < log.chunks(); ++i) {
+      rows.clear();
+      if (!log.read(i, rows)) {
+        return(false);
+      }
+      for (size_t r = 0; r < rows.size(); ++r) {
+        addSample(s, rows[r].sample); // The original timestamps, so a restart epoch is not waited out
+      }
+    }
+    return(true);
+  }
+  TelemetryIngest ingest;
+  if (!ingest.open(path)) {
+    return(false);
+  }
+  ingest.subscribe(TELEM_SAMPLE, collectSpan, &s);
+  return(ingest.run());
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Opens the output non-blocking. "pty" creates a pseudo-terminal in raw
+// mode and prints the name of its slave side for the consumer.
+////////////////////////////////////////////////////////////////////////////
+static int openOutput(const char* path, int &slave) {
+  slave = -1;
+  int fd;
+  if (strcmp(path, "-") == 0) {
+    fd = dup(STDOUT_FILENO);
+  }
+  else if (strcmp(path, "pty") == 0) {
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+      return(-1);
+    }
+    // Hold the slave open in raw mode so nothing written before the consumer attaches is mangled
+    slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (slave >= 0 && tcgetattr(slave, &tio) == 0) {
+      cfmakeraw(&tio);
+      tcsetattr(slave, TCSANOW, &tio);
+    }
+    fprintf(stderr, "replaying on %s\n", ptsname(fd));
+  }
+  else {
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644); // Blocks on a FIFO until a reader opens it
+  }
+  if (fd >= 0) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
+  return(fd);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Writes all of data, waiting for the consumer whenever the output is
+// full. Returns false if the consumer went away.
+////////////////////////////////////////////////////////////////////////////
+static bool writeAll(int fd, const uint8_t* data, size_t len, ReplayStats &stats) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n > 0) {
+      data += n;
+      len -= n;
+      stats.bytes += n;
+      ++stats.writes;
+      continue;
+    }
+    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      return(false);
+    }
+    ++stats.stalls;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    struct pollfd p = {fd, POLLOUT, 0};
+    poll(&p, 1, -1);
+    stats.blockedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Waits for the consumer to read what is still queued in the pseudo-
+// terminal, so closing it does not throw the tail of the session away.
+// The kernel moves data to the slave side asynchronously, so the queue
+// must stay empty for a while before it counts as drained. Gives up after
+// a second without progress.
+////////////////////////////////////////////////////////////////////////////
+static void drainPty(int slave) {
+  int last = -1;
+  int idle = 0;
+  int empty = 0;
+  int queued;
+  while (empty < 50 && idle < 1000 && ioctl(slave, FIONREAD, &queued) == 0) {
+    empty = (queued == 0) ? empty + 1 : 0;
+    idle = (queued == last && queued > 0) ? idle + 1 : 0;
+    last = queued;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+int main(int argc, char** argv) {
+  double speed = 1.0; // 0 for as fast as possible
+  uint8_t maxBatch = TelemetryBatch::fit(sizeof(TelemetryTimedAttitude), REPLAY_RADIO_ENCODED);
+  long batch = 0;
+  double waitSeconds = 0;
+  bool valid = true;
+  int arg = 1;
+  for (; arg + 1 < argc && argv[arg][0] == '-' && argv[arg][1] != 0; arg += 2) {
+    if (strcmp(argv[arg], "-s") == 0) {
+      speed = (strcmp(argv[arg + 1], "max") == 0) ? 0 : atof(argv[arg + 1]);
+    }
+    else if (strcmp(argv[arg], "-b") == 0) {
+      char* end;
+      batch = strtol(argv[arg + 1], &end, 10);
+      valid = valid && *end == 0 && batch >= 0 && batch <= maxBatch;
+    }
+    else if (strcmp(argv[arg], "-w") == 0) {
+      waitSeconds = atof(argv[arg + 1]);
+    }
+    else {
+      break;
+    }
+  }
+  if (arg >= argc || speed < 0 || !valid) {
+    fprintf(stderr, "usage: replay [-s speed|max] [-b records] [-w seconds] capture.bin|session.adl [pipe|file|pty|-]\n");
+    fprintf(stderr, "       -b takes 0 (one TELEM_SAMPLE frame per sample) to %u records per radio packet\n", maxBatch);
+    return(1);
+  }
+  const char* input = argv[arg];
+  const char* output = (arg + 1 < argc) ? argv[arg + 1] : "-";
+
+  Session session;
+  if (!loadSession(input, session) || session.samples.empty()) {
+    fprintf(stderr, "%s: no samples\n", input);
+    return(1);
+  }
+  int slave;
+  int fd = openOutput(output, slave);
+  if (fd < 0) {
+    perror(output);
+    return(1);
+  }
+  if (waitSeconds > 0) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(waitSeconds));
+  }
+
+  TelemetryBatch batcher(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), (uint8_t)batch, 0xFFFFFFFFUL,
+                         REPLAY_RADIO_ENCODED);
+  std::vector<uint8_t> out;
+  out.reserve(REPLAY_WRITE + TELEMETRY_MAX_ENCODED);
+  uint8_t frame[TELEMETRY_MAX_ENCODED];
+  uint16_t seq = 0;
+  double dueUs = 0; // Send time of the oldest frame waiting in out
+  ReplayStats stats;
+  memset(&stats, 0, sizeof(stats));
+  bool ok = true;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  size_t count = session.samples.size();
+  for (size_t i = 0; i < count && ok; ++i) {
+    size_t len;
+    if (batch) {
+      const ADIS16480Sample &sample = session.samples[i];
+      TelemetryTimedAttitude record; // As batchWirelessSensorData() builds it on the TX board
+      record.timestamp = sample.timestamp;
+      record.roll = sample.euler[0];
+      record.pitch = sample.euler[1];
+      record.yaw = sample.euler[2];
+      len = batcher.add(&record, 0) || i + 1 == count ? batcher.encode(seq, frame, sizeof(frame)) : 0;
+    }
+    else {
+      len = telemetryEncode(TELEM_SAMPLE, seq, (const uint8_t*)&session.samples[i], sizeof(ADIS16480Sample),
+                            frame, sizeof(frame));
+    }
+    if (len) {
+      if (out.empty()) {
+        dueUs = speed > 0 ? session.times[i] / speed : 0;
+      }
+      out.insert(out.end(), frame, frame + len);
+      ++seq;
+      ++stats.frames;
+    }
+
+    // Frames whose send time has come, or is about to, go out together in one write
+    double nextUs = (i + 1 < count && speed > 0) ? session.times[i + 1] / speed : 0;
+    double nowUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (i + 1 < count && out.size() < REPLAY_WRITE && nextUs <= nowUs + REPLAY_EARLY_US) {
+      continue;
+    }
+    if (!out.empty()) {
+      double lagMs = speed > 0 ? (nowUs - dueUs) / 1000.0 : 0;
+      stats.maxLagMs = lagMs > stats.maxLagMs ? lagMs : stats.maxLagMs;
+      ok = writeAll(fd, out.data(), out.size(), stats);
+      out.clear();
+    }
+    if (i + 1 < count && speed > 0) {
+      std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::micro>(nextUs)));
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (!ok) {
+    perror(output);
+  }
+  if (slave >= 0) {
+    drainPty(slave);
+    close(slave);
+  }
+  close(fd);
+
+  double recorded = session.times.back() / 1e6;
+  fprintf(stderr, "samples %llu, frames %llu, bytes %llu, recorded %.3f s, replayed %.3f s, speed %.2fx, "
+          "%.0f samples/s, %.0f bytes/s, writes %llu, stalls %llu, blocked %.3f s, max lag %.3f ms\n",
+          (unsigned long long)count, (unsigned long long)stats.frames, (unsigned long long)stats.bytes,
+          recorded, seconds, seconds > 0 ? recorded / seconds : 0.0, seconds > 0 ? count / seconds : 0.0,
+          seconds > 0 ? stats.bytes / seconds : 0.0, (unsigned long long)stats.writes,
+          (unsigned long long)stats.stalls, stats.blockedSeconds, stats.maxLagMs);
+  return(ok ? 0 : 1);
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADF7242Link.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ADF7242Link.h"
+
+ADF7242Link::ADF7242Link(uint32_t seed) : _state(seed ? seed : 1), _loss(0), _corruption(0), _delay(0), _jitter(0) {
+  clearStats();
+}
+
+void ADF7242Link::attach(ADF7242Sim &radio) {
+  _radios.push_back(&radio);
+  radio.setLink(this);
+}
+
+void ADF7242Link::setLoss(double p) {
+  _loss = p;
+}
+
+void ADF7242Link::setCorruption(double p) {
+  _corruption = p;
+}
+
+void ADF7242Link::setDelay(uint64_t ns, uint64_t jitterNs) {
+  _delay = ns;
+  _jitter = jitterNs;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Hands one copy of the packet to every other radio on the channel. Loss,
+// corruption, and jitter are drawn per copy.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242Link::send(ADF7242Sim* from, const std::vector<uint8_t> &payload, uint64_t endNs, uint64_t airNs) {
+  ++_stats.sent;
+  _stats.airNs += airNs;
+  for (size_t i = 0; i < _radios.size(); ++i) {
+    if (_radios[i] == from) {
+      continue;
+    }
+    if (chance(_loss)) {
+      ++_stats.lost;
+      continue;
+    }
+    uint64_t arrival = endNs + _delay + (_jitter ? random() % (_jitter + 1) : 0);
+    if (!payload.empty() && chance(_corruption)) {
+      std::vector<uint8_t> damaged(payload);
+      uint32_t bit = random() % (damaged.size() * 8);
+      damaged[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+      ++_stats.corrupted;
+      _radios[i]->deliver(damaged, arrival);
+    } else {
+      _radios[i]->deliver(payload, arrival);
+    }
+    ++_stats.delivered;
+  }
+}
+
+ADF7242LinkStats ADF7242Link::stats() const {
+  return(_stats);
+}
+
+void ADF7242Link::clearStats() {
+  ADF7242LinkStats zero = {0, 0, 0, 0, 0};
+  _stats = zero;
+}
+
+uint32_t ADF7242Link::random() {
+  _state ^= _state << 13;
+  _state ^= _state >> 17;
+  _state ^= _state << 5;
+  return(_state);
+}
+
+bool ADF7242Link::chance(double p) {
+  return(p > 0 && random() < p * 4294967296.0);
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADF7242Link.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Radio channel joining simulated ADF7242 radios. Every packet sent by one radio reaches each of
+//  the others after a fixed delay plus optional jitter, unless it is lost; a corrupted packet has one
+//  payload bit flipped. Loss and corruption come from a seeded generator, so a run with the same
+//  seed and traffic is repeatable.
+//
+//  All radios share one time base: drive their HostSPITransports so that none runs ahead of another
+//  by more than the shortest packet airtime.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ADF7242Link_h
+#define ADF7242Link_h
+
+#include "ADF7242Sim.h"
+
+// Channel counters accumulated since the last clearStats()
+struct ADF7242LinkStats {
+  unsigned long sent; // Packets put on air
+  unsigned long lost; // Copies dropped by the channel
+  unsigned long corrupted; // Copies delivered with a flipped bit
+  unsigned long delivered; // Copies handed to a receiving radio, corrupted or not
+  uint64_t airNs; // Time on air of every packet sent
+};
+
+// ADF7242Link class definition
+class ADF7242Link {
+public:
+  ADF7242Link(uint32_t seed = 1);
+
+  // Join a radio to the channel
+  void attach(ADF7242Sim &radio);
+
+  // Probability that a copy is lost, and that a delivered copy is corrupted, 0..1
+  void setLoss(double p);
+  void setCorruption(double p);
+
+  // Propagation and processing delay added after the last bit is sent, plus up to jitterNs more [ns]
+  void setDelay(uint64_t ns, uint64_t jitterNs = 0);
+
+  // Called by ADF7242Sim on RC_TX: the packet from one radio, airNs long, ends at endNs
+  void send(ADF7242Sim* from, const std::vector<uint8_t> &payload, uint64_t endNs, uint64_t airNs);
+
+  // Counters since the last clearStats()
+  ADF7242LinkStats stats() const;
+  void clearStats();
+
+private:
+  // xorshift32, the same sequence on every platform
+  uint32_t random();
+
+  // True with probability p
+  bool chance(double p);
+
+  std::vector<ADF7242Sim*> _radios;
+  uint32_t _state;
+  double _loss;
+  double _corruption;
+  uint64_t _delay;
+  uint64_t _jitter;
+  ADF7242LinkStats _stats;
+};
+
+#endif
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADF7242Sim.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ADF7242Sim.h"
+#include "ADF7242Link.h"
+#include <ADF7242.h>
+#include <algorithm>
+#include <string.h>
+
+// Status word bits
+#define STATUS_SPI_READY 0x80
+#define STATUS_IRQ 0x40
+#define STATUS_RC_READY 0x20
+
+// Orders arrivals by time
+struct ArrivalBefore {
+  template <class A> bool operator()(uint64_t ns, const A &a) const { return(ns < a.ns); }
+};
+
+ADF7242Sim::ADF7242Sim(int irq) : _irq(irq), _now(0), _lqi(0xFF), _rssi(0x80), _link(0) {
+  reset();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Power-on state: IDLE, memory cleared, nothing in flight. The data rate
+// registers start at 250 kbps until initFSK() loads a rate.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242Sim::reset() {
+  memset(_mem, 0, sizeof(_mem));
+  _mem[dr0] = 0x09;
+  _mem[dr1] = 0xC4;
+  _cmd = 0;
+  _addr = 0;
+  _bytes = 0;
+  _state = ADF7242SIM_IDLE;
+  _txEnd = 0;
+  _inbox.clear();
+  _lastCommand = 0;
+  _transmits = 0;
+  _rejected = 0;
+  _received = 0;
+  _missed = 0;
+}
+
+uint8_t ADF7242Sim::mem(uint16_t addr) const {
+  return(_mem[addr % ADF7242SIM_MEMORY]);
+}
+
+void ADF7242Sim::setMem(uint16_t addr, uint8_t value) {
+  _mem[addr % ADF7242SIM_MEMORY] = value;
+}
+
+void ADF7242Sim::receivePacket(const uint8_t* payload, uint8_t len, uint8_t lqi, uint8_t rssi) {
+  uint8_t base = _mem[rxpb];
+  _mem[base] = len + 2;
+  for (uint8_t i = 0; i < len; ++i) {
+    _mem[(uint8_t)(base + 1 + i)] = payload[i];
+  }
+  _mem[(uint8_t)(base + 1 + len)] = lqi;
+  _mem[(uint8_t)(base + 2 + len)] = rssi;
+  raise(irq1_src1, IRQ_RX_SFD | IRQ_RX_PKT_RCVD);
+}
+
+uint8_t ADF7242Sim::txPayload(uint8_t* buf, uint8_t maxLen) const {
+  uint8_t base = _mem[txpb];
+  uint8_t phr = _mem[base];
+  uint8_t len = (phr > 2) ? (phr - 2) : 0;
+  if (len > maxLen) {
+    len = maxLen;
+  }
+  for (uint8_t i = 0; i < len; ++i) {
+    buf[i] = _mem[(uint8_t)(base + 1 + i)];
+  }
+  return(len);
+}
+
+uint8_t ADF7242Sim::state() const {
+  return(_state);
+}
+
+uint32_t ADF7242Sim::dataRate() const {
+  return(((uint32_t)_mem[dr0] << 8 | _mem[dr1]) * 100UL);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Preamble, sync word, PHR, payload, and FCS bits at the dr0/dr1 rate
+////////////////////////////////////////////////////////////////////////////
+uint64_t ADF7242Sim::airtime(uint8_t len) const {
+  uint32_t rate = dataRate();
+  if (rate == 0) {
+    return(0);
+  }
+  uint64_t bytes = _mem[fsk_preamble] + ((_mem[sync_config] & 0x1F) + 7) / 8 + 1 + len + 2;
+  return((bytes * 8 * 1000000000ULL + rate - 1) / rate);
+}
+
+uint8_t ADF7242Sim::lastCommand() const {
+  return(_lastCommand);
+}
+
+unsigned long ADF7242Sim::transmits() const {
+  return(_transmits);
+}
+
+unsigned long ADF7242Sim::rejected() const {
+  return(_rejected);
+}
+
+unsigned long ADF7242Sim::received() const {
+  return(_received);
+}
+
+unsigned long ADF7242Sim::missed() const {
+  return(_missed);
+}
+
+void ADF7242Sim::setLink(ADF7242Link* link) {
+  _link = link;
+}
+
+void ADF7242Sim::setSignal(uint8_t lqi, uint8_t rssi) {
+  _lqi = lqi;
+  _rssi = rssi;
+}
+
+void ADF7242Sim::deliver(const std::vector<uint8_t> &payload, uint64_t arrivalNs) {
+  Arrival a = {arrivalNs, payload};
+  _inbox.insert(std::upper_bound(_inbox.begin(), _inbox.end(), arrivalNs, ArrivalBefore()), a);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Runs the end of a transmission and every arrival up to nowNs in time
+// order. The state only changes on SPI commands, which are applied after
+// this catches up, so an arrival sees the state the radio was in at the
+// time. A packet is taken in only in RX, after which the radio falls
+// back to PHY_RDY, as it does after sending.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242Sim::advanceTo(uint64_t nowNs) {
+  if (nowNs > _now) {
+    _now = nowNs;
+  }
+  for (;;) {
+    bool txDue = (_state == ADF7242SIM_TX && _txEnd <= _now);
+    bool rxDue = (!_inbox.empty() && _inbox.front().ns <= _now);
+    if (txDue && (!rxDue || _txEnd <= _inbox.front().ns)) {
+      _state = ADF7242SIM_PHY_RDY;
+      raise(irq1_src1, IRQ_TX_SFD | IRQ_TX_PKT_SENT);
+      raise(irq1_src0, IRQ_RC_READY);
+    } else if (rxDue) {
+      const std::vector<uint8_t> &p = _inbox.front().payload;
+      if (_state == ADF7242SIM_RX) {
+        receivePacket(p.data(), (uint8_t)p.size(), _lqi, _rssi);
+        _state = ADF7242SIM_PHY_RDY;
+        ++_received;
+      } else {
+        ++_missed;
+      }
+      _inbox.erase(_inbox.begin());
+    } else {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Radio controller commands. While a packet is on air the controller is
+// not ready and commands are dropped, as on the part.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242Sim::command(uint8_t cmd) {
+  _lastCommand = cmd;
+  if (cmd == RC_RESET) {
+    reset();
+    _state = ADF7242SIM_SLEEP;
+    return;
+  }
+  if (_state == ADF7242SIM_TX) {
+    ++_rejected;
+    return;
+  }
+  switch (cmd) {
+    case RC_SLEEP:
+      _state = ADF7242SIM_SLEEP;
+      break;
+    case RC_IDLE:
+      _state = ADF7242SIM_IDLE;
+      break;
+    case RC_PHY_RDY:
+      _state = ADF7242SIM_PHY_RDY;
+      raise(irq1_src0, IRQ_RC_READY);
+      break;
+    case RC_RX:
+      _state = ADF7242SIM_RX;
+      break;
+    case RC_MEAS:
+      _state = ADF7242SIM_MEAS;
+      break;
+    case RC_CCA:
+      raise(irq1_src1, IRQ_CCA_COMPLETE);
+      break;
+    case RC_TX: {
+      uint8_t base = _mem[txpb];
+      uint8_t phr = _mem[base];
+      std::vector<uint8_t> payload(phr > 2 ? phr - 2 : 0);
+      for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = _mem[(uint8_t)(base + 1 + i)];
+      }
+      uint64_t air = airtime((uint8_t)payload.size());
+      _state = ADF7242SIM_TX;
+      _txEnd = _now + ADF7242SIM_TURNAROUND_NS + air;
+      ++_transmits;
+      if (_link) {
+        _link->send(this, payload, _txEnd, air);
+      }
+      break;
+    }
+  }
+}
+
+uint8_t ADF7242Sim::status() const {
+  if (_state == ADF7242SIM_SLEEP) {
+    return(0);
+  }
+  bool irq = (_mem[irq1_src0] & _mem[irq1_en0]) || (_mem[irq1_src1] & _mem[irq1_en1]);
+  return(STATUS_SPI_READY | (irq ? STATUS_IRQ : 0) | (_state != ADF7242SIM_TX ? STATUS_RC_READY : 0) | _state);
+}
+
+void ADF7242Sim::raise(uint16_t srcAddr, uint8_t bits) {
+  _mem[srcAddr] |= bits;
+}
+
+// Asserting CS wakes a sleeping radio into IDLE
+void ADF7242Sim::select(uint64_t nowNs, uint32_t clock, uint8_t dataMode) {
+  advanceTo(nowNs);
+  if (_state == ADF7242SIM_SLEEP) {
+    _state = ADF7242SIM_IDLE;
+  }
+  _bytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Decodes the command in the first byte and moves the memory pointer as
+// the frame goes on:
+//   SPI_MEM_WR/SPI_MEMR_WR  cmd, addr, data...
+//   SPI_MEM_RD/SPI_MEMR_RD  cmd, addr, NOP, data...
+//   SPI_PKT_WR              cmd, data... from txpb
+//   SPI_PKT_RD              cmd, status, data... from rxpb
+//   RC_*                    single byte radio controller command
+// Writing a 1 to an irq1_src bit clears it.
+////////////////////////////////////////////////////////////////////////////
+uint8_t ADF7242Sim::exchange(uint8_t mosi) {
+  uint8_t s = status();
+  int n = _bytes++;
+  if (n == 0) {
+    _cmd = mosi;
+    if ((mosi & 0xF0) == 0xB0 || mosi == RC_RESET) {
+      command(mosi);
+    } else if (mosi == SPI_PKT_WR) {
+      _addr = _mem[txpb];
+    } else if (mosi == SPI_PKT_RD) {
+      _addr = _mem[rxpb];
+    }
+    return(s);
+  }
+
+  uint8_t op = _cmd & 0xF8;
+  if (_cmd == SPI_PKT_WR) {
+    _mem[_addr & 0xFF] = mosi;
+    _addr = (_addr + 1) & 0xFF;
+    return(s);
+  }
+  if (_cmd == SPI_PKT_RD) {
+    if (n == 1) {
+      return(s);
+    }
+    uint8_t v = _mem[_addr & 0xFF];
+    _addr = (_addr + 1) & 0xFF;
+    return(v);
+  }
+  if (op == SPI_MEM_WR || op == SPI_MEMR_WR || op == SPI_MEM_RD || op == SPI_MEMR_RD) {
+    if (n == 1) {
+      _addr = ((_cmd & 0x07) << 8) | mosi;
+      return(s);
+    }
+    uint16_t addr = _addr % ADF7242SIM_MEMORY;
+    if (op == SPI_MEM_WR || op == SPI_MEMR_WR) {
+      if (addr == irq1_src0 || addr == irq1_src1) {
+        _mem[addr] &= ~mosi;
+      } else {
+        _mem[addr] = mosi;
+      }
+      ++_addr;
+      return(s);
+    }
+    if (n == 2) {
+      return(s); // NOP before the first data byte
+    }
+    ++_addr;
+    return(_mem[addr]);
+  }
+  return(s);
+}
+
+// IRQ1 is high while any enabled source bit is set
+int ADF7242Sim::pinRead(int pin, uint64_t nowNs) {
+  advanceTo(nowNs);
+  if (pin != _irq) {
+    return(LOW);
+  }
+  return((status() & STATUS_IRQ) ? HIGH : LOW);
+}
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADF7242Sim.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Behavioral model of the ADF7242 for host builds: packet RAM (0x000..0x0FF) and the register map
+//  (0x100..0x3FF) behind the SPI_MEM/SPI_MEMR/SPI_PKT commands, the radio controller states, the
+//  status word returned with the first byte of every frame, and the IRQ1 source bits and pin.
+//
+//  RC_TX sends the packet at txpb. It lasts the TX turnaround plus its airtime at the data rate in
+//  dr0/dr1, counting the preamble (fsk_preamble), sync word (sync_config), PHR, payload, and FCS.
+//  A radio joined to an ADF7242Link hands the packet to the link, which delivers it to the other
+//  radios; one listening in RX at the arrival time stores it at rxpb and raises IRQ_RX_PKT_RCVD.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ADF7242Sim_h
+#define ADF7242Sim_h
+
+#include <HostSPITransport.h>
+
+#define ADF7242SIM_MEMORY 0x400 // Packet RAM and register map
+#define ADF7242SIM_TURNAROUND_NS 140000ULL // PHY_RDY to first preamble bit on RC_TX [ns]
+
+// Radio controller states, as reported in the status word (RC_STATUS, bits 3..0)
+#define ADF7242SIM_SLEEP 0x00
+#define ADF7242SIM_IDLE 0x01
+#define ADF7242SIM_MEAS 0x02
+#define ADF7242SIM_PHY_RDY 0x03
+#define ADF7242SIM_RX 0x04
+#define ADF7242SIM_TX 0x05
+
+class ADF7242Link;
+
+// ADF7242Sim class definition
+class ADF7242Sim : public SPIDevice {
+public:
+  // Simulated radio whose IRQ1 line is pin irq (-1 when not routed)
+  ADF7242Sim(int irq = -1);
+
+  // Restore the power-on state (RC_RESET does the same)
+  void reset();
+
+  // Packet RAM and register contents
+  uint8_t mem(uint16_t addr) const;
+  void setMem(uint16_t addr, uint8_t value);
+
+  // Store a received packet at rxpb the way the radio does (PHR, payload, LQI, RSSI) and raise IRQ_RX_PKT_RCVD
+  void receivePacket(const uint8_t* payload, uint8_t len, uint8_t lqi = 0xFF, uint8_t rssi = 0x80);
+
+  // Payload at txpb, as the radio would send it. Returns the payload length.
+  uint8_t txPayload(uint8_t* buf, uint8_t maxLen) const;
+
+  // Radio controller state (ADF7242SIM_*)
+  uint8_t state() const;
+
+  // Data rate from dr0/dr1 [bps]
+  uint32_t dataRate() const;
+
+  // Time on air of a packet carrying len payload bytes, at the configured data rate [ns]
+  uint64_t airtime(uint8_t len) const;
+
+  // Last radio controller command (RC_*), RC_TX commands that started a packet, and commands ignored while sending
+  uint8_t lastCommand() const;
+  unsigned long transmits() const;
+  unsigned long rejected() const;
+
+  // Packets received, and packets that arrived while the radio was not in RX
+  unsigned long received() const;
+  unsigned long missed() const;
+
+  // Join the link that carries this radio's packets (0 to leave it), and set the LQI/RSSI stored with received packets
+  void setLink(ADF7242Link* link);
+  void setSignal(uint8_t lqi, uint8_t rssi);
+
+  // Called by ADF7242Link: a packet payload ends arriving at arrivalNs
+  void deliver(const std::vector<uint8_t> &payload, uint64_t arrivalNs);
+
+  // SPIDevice interface
+  void select(uint64_t nowNs, uint32_t clock, uint8_t dataMode);
+  uint8_t exchange(uint8_t mosi);
+  int pinRead(int pin, uint64_t nowNs);
+
+private:
+  struct Arrival {
+    uint64_t ns;
+    std::vector<uint8_t> payload;
+  };
+
+  // Finish a transmission and take in arrivals up to nowNs
+  void advanceTo(uint64_t nowNs);
+
+  // Act on a radio controller command
+  void command(uint8_t cmd);
+
+  // Status word: SPI_READY, IRQ_STATUS, RC_READY, RC_STATUS
+  uint8_t status() const;
+
+  // Raise IRQ1 source bits
+  void raise(uint16_t src0Addr, uint8_t bits);
+
+  uint8_t _mem[ADF7242SIM_MEMORY];
+  uint8_t _cmd; // First byte of the current frame
+  uint16_t _addr; // Memory pointer of the current frame
+  int _bytes; // Bytes exchanged in the current frame
+  uint8_t _state;
+  int _irq;
+  uint64_t _now; // Latest modeled time seen
+  uint64_t _txEnd; // End of the packet being sent
+  uint8_t _lqi;
+  uint8_t _rssi;
+  ADF7242Link* _link;
+  std::vector<Arrival> _inbox; // Packets on their way, oldest arrival first
+  uint8_t _lastCommand;
+  unsigned long _transmits;
+  unsigned long _rejected;
+  unsigned long _received;
+  unsigned long _missed;
+};
+
+#endif
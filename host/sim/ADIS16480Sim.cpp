@@ -0,0 +1,364 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADIS16480Sim.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ADIS16480Sim.h"
+#include <Telemetry.h>
+#include <stdio.h>
+#include <string.h>
+
+// Euler angle outputs, the registers a tare zeroes
+static const uint16_t eulerRegs[3] = {ROLL_C23_OUT, PITCH_C31_OUT, YAW_C32_OUT};
+
+ADIS16480Sim::ADIS16480Sim(int rst) : _rst(rst), _now(0), _stallNs(ADIS16480SIM_STALL_NS), _replayLoop(true) {
+  reset();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Power cycle at the current modeled time. The sensor answers at once (the
+// start up time is only modeled for resets), data ready is rescheduled, and
+// a replay starts over from its first sample.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::reset() {
+  defaults();
+  memcpy(_flash, _regs, sizeof(_regs));
+  _tare[0] = _tare[1] = _tare[2] = 0;
+  _page = 0;
+  _in = 0;
+  _out = 0;
+  _bytes = 0;
+  _violation = false;
+  _inReset = false;
+  _quietUntil = 0;
+  _readyAt = _now;
+  _lastUpdate = _now;
+  _nextUpdate = _now + samplePeriod();
+  _replayPos = 0;
+  _replayed = 0;
+  _frames = 0;
+  _violations = 0;
+  _updates = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Every register zero except the ones with a documented default in the
+// register map (Table 9)
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::defaults() {
+  memset(_regs, 0, sizeof(_regs));
+  setReg(PROD_ID, ADIS16480_PROD_ID);
+  setReg(REFMTX_R11, 0x7FFF);
+  setReg(REFMTX_R22, 0x7FFF);
+  setReg(REFMTX_R33, 0x7FFF);
+  setReg(FNCTIO_CTRL, 0x000D);
+  setReg(CONFIG, 0x00C0);
+  setReg(EKF_CNFG, 0x0200);
+  setReg(ACC_DISTB_THR, 0x0020);
+  setReg(MAG_DISTB_THR, 0x0030);
+  setReg(QCVR_NOIS_LWR, 0xC5AC);
+  setReg(QCVR_NOIS_UPR, 0x3727);
+  setReg(QCVR_RRW_LWR, 0xE6FF);
+  setReg(QCVR_RRW_UPR, 0x2E5B);
+  setReg(RCVR_ACC_LWR, 0x705F);
+  setReg(RCVR_ACC_UPR, 0x3189);
+  setReg(RCVR_MAG_LWR, 0xCC77);
+  setReg(RCVR_MAG_UPR, 0x32AB);
+}
+
+uint16_t ADIS16480Sim::reg(uint16_t regAddr) const {
+  return(_regs[(regAddr >> 8) % ADIS16480SIM_PAGES][(regAddr & 0x7F) >> 1]);
+}
+
+void ADIS16480Sim::setReg(uint16_t regAddr, uint16_t value) {
+  _regs[(regAddr >> 8) % ADIS16480SIM_PAGES][(regAddr & 0x7F) >> 1] = value;
+}
+
+void ADIS16480Sim::dataReady() {
+  update();
+}
+
+uint64_t ADIS16480Sim::nextDataReady() const {
+  return(_nextUpdate);
+}
+
+uint64_t ADIS16480Sim::samplePeriod() const {
+  uint64_t decimation = (uint64_t)reg(DEC_RATE) + 1;
+  return((1000000000ULL * decimation + ADIS16480_BASE_RATE / 2) / ADIS16480_BASE_RATE);
+}
+
+void ADIS16480Sim::replay(const std::vector<ADIS16480Sample> &samples, bool loop) {
+  _replay = samples;
+  _replayLoop = loop;
+  _replayPos = 0;
+  _replayed = 0;
+}
+
+unsigned long ADIS16480Sim::replayed() const {
+  return(_replayed);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// size_t loadCapture(const char* path, std::vector<ADIS16480Sample> &samples)
+////////////////////////////////////////////////////////////////////////////
+// Reads a capture of framed telemetry, as streamed by the sketches and
+// read by teledump, and appends every TELEM_SAMPLE payload and every sample
+// record of a TELEM_BATCH frame. Damaged frames are skipped.
+////////////////////////////////////////////////////////////////////////////
+// path - capture file
+// samples - receives the samples in capture order
+// return - number of samples appended, 0 if the file cannot be read
+////////////////////////////////////////////////////////////////////////////
+size_t ADIS16480Sim::loadCapture(const char* path, std::vector<ADIS16480Sample> &samples) {
+  FILE* in = fopen(path, "rb");
+  if (!in) {
+    return(0);
+  }
+  size_t before = samples.size();
+  uint8_t buf[TELEMETRY_MAX_ENCODED];
+  size_t len = 0;
+  int c;
+  while ((c = fgetc(in)) != EOF) {
+    if (c != 0x00) {
+      if (len < sizeof(buf)) {
+        buf[len++] = (uint8_t)c;
+      }
+      continue;
+    }
+    TelemetryFrame frame;
+    if (len > 0 && len < sizeof(buf) && telemetryDecode(buf, len, frame) == TELEMETRY_OK) {
+      ADIS16480Sample s;
+      uint8_t recordType;
+      uint8_t recordSize;
+      const uint8_t* records;
+      uint8_t count = telemetryBatchRecords(frame, recordType, recordSize, records);
+      if (frame.type == TELEM_SAMPLE && frame.length == sizeof(s)) {
+        memcpy(&s, frame.payload, sizeof(s));
+        samples.push_back(s);
+      } else if (count > 0 && recordType == TELEM_SAMPLE && recordSize == sizeof(s)) {
+        for (uint8_t i = 0; i < count; ++i) {
+          memcpy(&s, records + i * recordSize, sizeof(s));
+          samples.push_back(s);
+        }
+      }
+    }
+    len = 0;
+  }
+  fclose(in);
+  return(samples.size() - before);
+}
+
+void ADIS16480Sim::setStall(uint64_t ns) {
+  _stallNs = ns;
+}
+
+unsigned long ADIS16480Sim::frames() const {
+  return(_frames);
+}
+
+unsigned long ADIS16480Sim::stallViolations() const {
+  return(_violations);
+}
+
+unsigned long ADIS16480Sim::updates() const {
+  return(_updates);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Runs every data ready edge up to nowNs. Nothing updates while RST is
+// held low or during the start up time.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::advanceTo(uint64_t nowNs) {
+  if (nowNs > _now) {
+    _now = nowNs;
+  }
+  if (_inReset) {
+    return;
+  }
+  while (_nextUpdate <= _now) {
+    _lastUpdate = _nextUpdate;
+    update();
+    _nextUpdate += samplePeriod();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// One output register update: SEQ_CNT advances and, with a replay set, the
+// next recorded sample replaces the sensor outputs
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::update() {
+  setReg(SEQ_CNT, reg(SEQ_CNT) + 1);
+  ++_updates;
+  if (_replay.empty() || (!_replayLoop && _replayPos >= _replay.size())) {
+    return;
+  }
+  loadSample(_replay[_replayPos % _replay.size()]);
+  ++_replayPos;
+  ++_replayed;
+}
+
+// Splits the 32 bit fields back into their _OUT (upper) and _LOW (lower) registers
+void ADIS16480Sim::loadSample(const ADIS16480Sample &s) {
+  static const uint16_t gyroRegs[3] = {X_GYRO_LOW, Y_GYRO_LOW, Z_GYRO_LOW};
+  static const uint16_t acclRegs[3] = {X_ACCL_LOW, Y_ACCL_LOW, Z_ACCL_LOW};
+  static const uint16_t magnRegs[3] = {X_MAGN_OUT, Y_MAGN_OUT, Z_MAGN_OUT};
+  static const uint16_t deltAngRegs[3] = {X_DELTANG_LOW, Y_DELTANG_LOW, Z_DELTANG_LOW};
+  static const uint16_t deltVelRegs[3] = {X_DELTVEL_LOW, Y_DELTVEL_LOW, Z_DELTVEL_LOW};
+
+  setReg(SYS_E_FLAG, s.sysEFlag);
+  setReg(TEMP_OUT, (uint16_t)s.temp);
+  for (int i = 0; i < 3; ++i) {
+    setReg(gyroRegs[i], (uint16_t)s.gyro[i]);
+    setReg(gyroRegs[i] + 2, (uint16_t)((uint32_t)s.gyro[i] >> 16));
+    setReg(acclRegs[i], (uint16_t)s.accl[i]);
+    setReg(acclRegs[i] + 2, (uint16_t)((uint32_t)s.accl[i] >> 16));
+    setReg(magnRegs[i], (uint16_t)s.magn[i]);
+    setReg(deltAngRegs[i], (uint16_t)s.deltAng[i]);
+    setReg(deltAngRegs[i] + 2, (uint16_t)((uint32_t)s.deltAng[i] >> 16));
+    setReg(deltVelRegs[i], (uint16_t)s.deltVel[i]);
+    setReg(deltVelRegs[i] + 2, (uint16_t)((uint32_t)s.deltVel[i] >> 16));
+    setReg(eulerRegs[i], (uint16_t)(s.euler[i] - _tare[i]));
+  }
+  setReg(BAROM_LOW, (uint16_t)s.barom);
+  setReg(BAROM_OUT, (uint16_t)((uint32_t)s.barom >> 16));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// GLOB_CMD bits (Table 146). Self test, flash test, and bias correction
+// complete at once and pass.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::command(uint16_t bits, uint64_t nowNs) {
+  if (bits & 0x0100) { // Tare: the current attitude becomes the reference
+    for (int i = 0; i < 3; ++i) {
+      _tare[i] += (int16_t)reg(eulerRegs[i]);
+      setReg(eulerRegs[i], 0);
+    }
+  }
+  if (bits & 0x0040) { // Factory calibration restore
+    uint16_t seqCnt = reg(SEQ_CNT);
+    defaults();
+    setReg(SEQ_CNT, seqCnt);
+  }
+  if (bits & 0x0008) { // Flash memory update
+    memcpy(_flash, _regs, sizeof(_regs));
+  }
+  if (bits & 0x0080) { // Software reset
+    restart(nowNs);
+  }
+}
+
+// Registers come back from flash, SEQ_CNT and the tare restart, and the part is silent for the start up time
+void ADIS16480Sim::restart(uint64_t nowNs) {
+  memcpy(_regs, _flash, sizeof(_regs));
+  setReg(SEQ_CNT, 0);
+  _tare[0] = _tare[1] = _tare[2] = 0;
+  _page = 0;
+  _out = 0;
+  _readyAt = nowNs + ADIS16480SIM_START_NS;
+  _lastUpdate = _readyAt;
+  _nextUpdate = _readyAt + samplePeriod();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// A frame starting less than the stall time after the previous one ended
+// is not decoded; the sensor answers it with whatever it was shifting out.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::select(uint64_t nowNs, uint32_t clock, uint8_t dataMode) {
+  advanceTo(nowNs);
+  _in = 0;
+  _bytes = 0;
+  _violation = nowNs < _quietUntil;
+}
+
+uint8_t ADIS16480Sim::exchange(uint8_t mosi) {
+  uint8_t miso = (_bytes == 0) ? (_out >> 8) : (_out & 0xFF);
+  _in = (_in << 8) | mosi;
+  ++_bytes;
+  return(miso);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Acts on the frame just completed. A read loads the word returned by the
+// next frame; a write (bit 15 set) updates one byte of a register, selects
+// a page when it targets PAGE_ID, or runs a GLOB_CMD command. Output
+// registers and PROD_ID ignore writes.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::deselect(uint64_t nowNs) {
+  advanceTo(nowNs);
+  _quietUntil = nowNs + _stallNs;
+  if (_bytes != 2 || _inReset || nowNs < _readyAt) {
+    return; // Not a 16 bit frame, or the part is not running
+  }
+  if (_violation) {
+    ++_violations;
+    return;
+  }
+  ++_frames;
+  uint8_t address = (_in >> 8) & 0x7F;
+  uint16_t regAddr = (_page << 8) | (address & 0x7E);
+  if (_in & 0x8000) {
+    uint8_t data = _in & 0xFF;
+    if (address <= 0x01) {
+      _page = data % ADIS16480SIM_PAGES;
+    } else if (regAddr == GLOB_CMD) {
+      command((address & 1) ? (data << 8) : data, nowNs);
+    } else if (!(_page == 0 && ((address >= (SEQ_CNT & 0x7F) && address <= (Z_DELTVEL_OUT & 0x7F) + 1)
+                                || address >= (PROD_ID & 0x7F)))) {
+      uint16_t &r = _regs[_page][address >> 1];
+      r = (address & 1) ? ((r & 0x00FF) | (data << 8)) : ((r & 0xFF00) | data);
+    }
+    _out = 0;
+  } else if (address <= 0x01) {
+    _out = _page;
+  } else {
+    _out = (regAddr == GLOB_CMD) ? 0 : _regs[_page][address >> 1];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// RST low holds the part in reset; the rising edge restarts it from flash
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480Sim::pinWrite(int pin, int level, uint64_t nowNs) {
+  if (pin != _rst) {
+    return;
+  }
+  advanceTo(nowNs);
+  if (level == LOW) {
+    _inReset = true;
+  } else if (_inReset) {
+    _inReset = false;
+    restart(nowNs);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Data ready (DIO2, active high with the default FNCTIO_CTRL) rises at each
+// output register update and stays high for half the sample period
+////////////////////////////////////////////////////////////////////////////
+int ADIS16480Sim::pinRead(int pin, uint64_t nowNs) {
+  advanceTo(nowNs);
+  if (pin == _rst || _inReset || nowNs < _readyAt) {
+    return(LOW);
+  }
+  return((nowNs - _lastUpdate) < samplePeriod() / 2 ? HIGH : LOW);
+}
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ADIS16480Sim.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Behavioral model of the ADIS16480 SPI interface for host builds. Frames are 16 bits; a read
+//  request is answered during the next frame, writes go one byte at a time, and PAGE_ID selects one
+//  of the register pages. Data ready fires every (DEC_RATE + 1) / 2460 s of modeled time and advances
+//  SEQ_CNT, loading the next recorded sample into the output registers when a replay is set. Frames
+//  started before the stall time has elapsed are lost and counted. GLOB_CMD tare, flash update, and
+//  software reset are modeled, as is the RST pin.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ADIS16480Sim_h
+#define ADIS16480Sim_h
+
+#include <HostSPITransport.h>
+#include <ADIS16480.h>
+
+#define ADIS16480SIM_PAGES 13 // Pages 0..12 (FIR coefficient banks end on page 12)
+#define ADIS16480SIM_WORDS 64 // 16 bit registers per page
+#define ADIS16480SIM_STALL_NS 2000 // Minimum CS high time between frames (tSTALL) [ns]
+#define ADIS16480SIM_START_NS 500000000ULL // Start up time after a reset, SPI and data ready silent [ns]
+
+// ADIS16480Sim class definition
+class ADIS16480Sim : public SPIDevice {
+public:
+  // Simulated sensor whose RST line is pin rst (-1 when not routed)
+  ADIS16480Sim(int rst = -1);
+
+  // Power cycle: every register and the flash copy back to the factory defaults
+  void reset();
+
+  // Register contents, {PAGE_ID, Address} format
+  uint16_t reg(uint16_t regAddr) const;
+  void setReg(uint16_t regAddr, uint16_t value);
+
+  // Force a data ready update now, independent of the DEC_RATE schedule
+  void dataReady();
+
+  // Time of the next scheduled data ready rising edge [ns], for hosts advancing the bus to it
+  uint64_t nextDataReady() const;
+
+  // Data ready period at the current DEC_RATE [ns]
+  uint64_t samplePeriod() const;
+
+  // Feed recorded samples into the output registers, one per data ready, wrapping when loop is set
+  void replay(const std::vector<ADIS16480Sample> &samples, bool loop = true);
+
+  // Recorded samples loaded into the output registers since replay()
+  unsigned long replayed() const;
+
+  // Collect every ADIS16480Sample (single or batched) from a framed telemetry capture. Returns the count.
+  static size_t loadCapture(const char* path, std::vector<ADIS16480Sample> &samples);
+
+  // Set the minimum CS high time between frames [ns]
+  void setStall(uint64_t ns);
+
+  // Frames decoded, frames lost to stall violations, and data ready updates since reset()
+  unsigned long frames() const;
+  unsigned long stallViolations() const;
+  unsigned long updates() const;
+
+  // SPIDevice interface
+  void select(uint64_t nowNs, uint32_t clock, uint8_t dataMode);
+  uint8_t exchange(uint8_t mosi);
+  void deselect(uint64_t nowNs);
+  void pinWrite(int pin, int level, uint64_t nowNs);
+  int pinRead(int pin, uint64_t nowNs);
+
+private:
+  // Factory default register contents
+  void defaults();
+
+  // Bring the data ready schedule up to nowNs
+  void advanceTo(uint64_t nowNs);
+
+  // Output register update at a data ready edge
+  void update();
+
+  // Load one recorded sample into the output registers
+  void loadSample(const ADIS16480Sample &s);
+
+  // Apply one byte written to GLOB_CMD
+  void command(uint16_t bits, uint64_t nowNs);
+
+  // Reload the flash copy and restart after startNs of silence
+  void restart(uint64_t nowNs);
+
+  uint16_t _regs[ADIS16480SIM_PAGES][ADIS16480SIM_WORDS];
+  uint16_t _flash[ADIS16480SIM_PAGES][ADIS16480SIM_WORDS]; // Nonvolatile copy restored by a reset
+  int16_t _tare[3]; // Euler angles captured by the last tare
+  uint8_t _page;
+  uint16_t _in; // Word shifted in during the current frame
+  uint16_t _out; // Word shifted out during the current frame
+  int _bytes; // Bytes exchanged in the current frame
+  bool _violation; // Current frame started inside the stall time
+  int _rst;
+  bool _inReset; // RST held low
+  uint64_t _now; // Latest modeled time seen
+  uint64_t _stallNs;
+  uint64_t _quietUntil; // End of the stall time after the last frame
+  uint64_t _readyAt; // End of the start up time
+  uint64_t _lastUpdate; // Time of the last data ready edge
+  uint64_t _nextUpdate; // Time of the next data ready edge
+  std::vector<ADIS16480Sample> _replay;
+  size_t _replayPos;
+  bool _replayLoop;
+  unsigned long _replayed;
+  unsigned long _frames;
+  unsigned long _violations;
+  unsigned long _updates;
+};
+
+#endif
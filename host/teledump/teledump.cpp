@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host tool, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  teledump.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Decodes framed telemetry (see Telemetry.h) read from a file, a serial port, or stdin and prints
+//  one CSV line per record. Frame errors, sequence gaps, and throughput are summarized on stderr.
+//  With -o, samples are recorded to a SampleLog instead of printed.
+//
+//  Build:  cmake -S host -B build && cmake --build build   (see host/CMakeLists.txt)
+//  Usage:  teledump [-o session.adl] [file|/dev/ttyACM0]   (stdin when omitted)
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <TelemetryIngest.h>
+#include <SampleLog.h>
+#include <ADIS16480.h>
+#include <Profiler.h>
+#include <stdio.h>
+#include <string.h>
+
+// Print one sample, either a whole frame or one record of a batch
+static void dumpRecord(uint16_t seq, uint8_t type, const uint8_t* data, uint8_t size) {
+  if (type == TELEM_SAMPLE && size == sizeof(ADIS16480Sample)) {
+    const ADIS16480Sample* s = (const ADIS16480Sample*)data;
+    printf("%u,sample,%u,%u,%.3f,%.3f,%.3f,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f,%.2f,%.2f,%.2f\n",
+           seq, s->timestamp, s->seqCnt,
+           s->euler[0] * ADIS16480_EULER_SCALE, s->euler[1] * ADIS16480_EULER_SCALE, s->euler[2] * ADIS16480_EULER_SCALE,
+           s->gyro[0] * ADIS16480_GYRO_SCALE, s->gyro[1] * ADIS16480_GYRO_SCALE, s->gyro[2] * ADIS16480_GYRO_SCALE,
+           s->accl[0] * ADIS16480_ACCL_SCALE, s->accl[1] * ADIS16480_ACCL_SCALE, s->accl[2] * ADIS16480_ACCL_SCALE,
+           s->temp * ADIS16480_TEMP_SCALE + ADIS16480_TEMP_OFFSET,
+           s->barom * ADIS16480_BAROM_SCALE, s->magn[0] * ADIS16480_MAGN_SCALE);
+  }
+  else if (type == TELEM_ATTITUDE && size == sizeof(TelemetryAttitude)) {
+    const TelemetryAttitude* a = (const TelemetryAttitude*)data;
+    printf("%u,attitude,%.3f,%.3f,%.3f\n", seq,
+           a->roll * ADIS16480_EULER_SCALE, a->pitch * ADIS16480_EULER_SCALE, a->yaw * ADIS16480_EULER_SCALE);
+  }
+  else if (type == TELEM_TIMED_ATTITUDE && size == sizeof(TelemetryTimedAttitude)) {
+    const TelemetryTimedAttitude* a = (const TelemetryTimedAttitude*)data;
+    printf("%u,timed_attitude,%u,%.3f,%.3f,%.3f\n", seq, a->timestamp,
+           a->roll * ADIS16480_EULER_SCALE, a->pitch * ADIS16480_EULER_SCALE, a->yaw * ADIS16480_EULER_SCALE);
+  }
+  else if (type == TELEM_PROFILE && size == sizeof(ProfileRecord)) {
+    const ProfileRecord* p = (const ProfileRecord*)data;
+    double usPerTick = 1e6 / p->ticksPerSecond;
+    printf("%u,profile,%.*s,%u,%.3f,%.3f,%.3f", seq, PROFILE_NAME, p->name, p->count, p->min * usPerTick,
+           p->count ? p->total * usPerTick / p->count : 0.0, p->max * usPerTick);
+    for (int i = 0; i < PROFILE_BUCKETS; ++i) {
+      printf(",%u", p->buckets[i]);
+    }
+    printf("\n");
+  }
+  else {
+    printf("%u,0x%02X,%u bytes\n", seq, type, size);
+  }
+}
+
+// Print every record of a frame
+static void dumpSpan(const TelemetrySpan &span, void* arg) {
+  for (uint8_t i = 0; i < span.count; ++i) {
+    dumpRecord(span.seq, span.type, span.data + i * span.size, span.size);
+  }
+}
+
+// Record every sample of a frame, single or batched
+static void logSpan(const TelemetrySpan &span, void* arg) {
+  SampleLogWriter* log = (SampleLogWriter*)arg;
+  if (span.size != sizeof(ADIS16480Sample)) {
+    return;
+  }
+  for (uint8_t i = 0; i < span.count; ++i) {
+    ADIS16480Sample s;
+    memcpy(&s, span.data + i * span.size, sizeof(s));
+    log->append(s);
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* output = 0;
+  int arg = 1;
+  if (arg + 1 < argc && strcmp(argv[arg], "-o") == 0) {
+    output = argv[arg + 1];
+    arg += 2;
+  }
+  const char* source = (arg < argc) ? argv[arg] : "-";
+  TelemetryIngest ingest;
+  if (!ingest.open(source)) {
+    perror(source);
+    return(1);
+  }
+  SampleLogWriter log;
+  if (output) {
+    if (!log.open(output)) {
+      perror(output);
+      return(1);
+    }
+    ingest.subscribe(TELEM_SAMPLE, logSpan, &log);
+  }
+  else {
+    ingest.subscribe(TELEMETRY_ANY, dumpSpan);
+  }
+  if (!ingest.run()) {
+    perror(source);
+  }
+  if (output) {
+    if (!log.close()) {
+      perror(output);
+    }
+    fprintf(stderr, "%s: %llu samples, %llu bytes\n", output, (unsigned long long)log.rows(),
+            (unsigned long long)log.bytes());
+  }
+
+  TelemetryIngestStats s = ingest.stats();
+  fprintf(stderr, "frames %llu, lost %llu, bad cobs %llu, bad length %llu, bad crc %llu, bad version %llu, overlong %llu, "
+          "resyncs %llu, %.0f bytes/s, %.0f frames/s\n",
+          (unsigned long long)s.frames, (unsigned long long)s.lost, (unsigned long long)s.bad[TELEMETRY_BAD_COBS],
+          (unsigned long long)s.bad[TELEMETRY_BAD_LENGTH], (unsigned long long)s.bad[TELEMETRY_BAD_CRC],
+          (unsigned long long)s.bad[TELEMETRY_BAD_VERSION], (unsigned long long)s.overlong,
+          (unsigned long long)s.resyncs, s.bytesPerSecond(), s.framesPerSecond());
+  return(0);
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HostTest.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Minimal check macros shared by the host tests. A failed CHECK() prints where and what and lets
+//  the test carry on; testResult() turns the failure count into the exit status ctest looks at.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HostTest_h
+#define HostTest_h
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+// Report a failed condition and keep going
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      ++testFailures; \
+    } \
+  } while (0)
+
+// Same, comparing two integers and printing both
+#define CHECK_EQ(a, b) do { \
+    long long _a = (long long)(a); \
+    long long _b = (long long)(b); \
+    if (_a != _b) { \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+      ++testFailures; \
+    } \
+  } while (0)
+
+// Exit status for main(): 0 when every check passed
+static inline int testResult(const char* name) {
+  if (testFailures) {
+    fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+    return(1);
+  }
+  printf("%s: ok\n", name);
+  return(0);
+}
+
+#endif
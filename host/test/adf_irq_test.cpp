@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  adf_irq_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ADF7242::serviceIRQ() against two simulated radios on a lossless link: when the receiver raises
+//  IRQ1 the packet comes back intact, irq1_src1 is cleared, the pin drops, and RX is re-armed so the
+//  next packet is caught too. With the write-back cache on, cfgIRQ() must still reach the chip in
+//  program order: the irq1_en* writes it holds go out before clearIRQ() writes irq1_src*.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <HostSPITransport.h>
+#include <ADF7242.h>
+#include <ADF7242Sim.h>
+#include <ADF7242Link.h>
+#include <string.h>
+
+#define RADIO_CS 7
+#define RADIO_IRQ 2
+#define STEP_NS 10000
+
+struct Node {
+  HostSPITransport bus;
+  ADF7242Sim sim;
+  ADF7242 radio;
+
+  Node() : sim(RADIO_IRQ), radio(RADIO_CS, bus) {
+    bus.setRecording(false);
+    bus.attach(RADIO_CS, &sim);
+    bus.attachPin(RADIO_IRQ, &sim);
+  }
+
+  // Configured as the TX and RX sketches configure the radio
+  void bringUp(unsigned char irqSources) {
+    radio.configSPI();
+    radio.reset();
+    radio.idle();
+    radio.initFSK(5);
+    radio.setMode(0x04);
+    radio.chFreq(2450);
+    radio.syncWord(0x00, 0x00);
+    radio.cfgCRC(0);
+    radio.cfgBasicPreamble();
+    radio.cfgPB(0x080, 0x000);
+    radio.PHY_RDY();
+    radio.cfgIRQ(0x00, irqSources);
+  }
+};
+
+// Run both boards until the receiver's IRQ1 goes high, at most limitNs. Returns false on timeout.
+static bool waitIRQ(Node &tx, Node &rx, uint64_t limitNs) {
+  for (uint64_t t = 0; t < limitNs; t += STEP_NS) {
+    tx.bus.advance(STEP_NS);
+    rx.bus.advance(STEP_NS);
+    tx.bus.digitalRead(RADIO_IRQ); // Lets the transmitter finish its packet and hand it to the link
+    if (rx.bus.digitalRead(RADIO_IRQ) == HIGH) {
+      return(true);
+    }
+  }
+  return(false);
+}
+
+// Index of the first recorded write frame that covers regAddr, or -1
+static int writeFrame(const std::vector<SPIFrame> &frames, unsigned int regAddr) {
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const std::vector<uint8_t> &mosi = frames[i].mosi;
+    if (mosi.size() < 3 || ((mosi[0] & 0xF8) != SPI_MEM_WR && (mosi[0] & 0xF8) != SPI_MEMR_WR)) {
+      continue;
+    }
+    unsigned int start = ((mosi[0] & 0x07) << 8) | mosi[1];
+    if (regAddr >= start && regAddr < start + mosi.size() - 2) {
+      return((int)i);
+    }
+  }
+  return(-1);
+}
+
+// Held cached writes reach the chip ahead of a later write that bypasses the cache
+static void writeBackOrder() {
+  Node node;
+  node.bringUp(0x00);
+  node.radio.cacheEnable(true, true);
+  node.bus.setRecording(true);
+  node.radio.cfgIRQ(0x00, IRQ_RX_PKT_RCVD);
+  const std::vector<SPIFrame> &frames = node.bus.frames();
+  int en = writeFrame(frames, irq1_en1);
+  int src = writeFrame(frames, irq1_src1);
+  CHECK(en >= 0);
+  CHECK(src >= 0);
+  CHECK(en < src);
+  CHECK_EQ(node.sim.mem(irq1_en1), IRQ_RX_PKT_RCVD);
+  node.bus.clearFrames();
+
+  node.radio.regWrite(irq1_en1, 0x00); // Held
+  node.radio.PHY_RDY(); // vco_cal_cfg is volatile, so its write bypasses the cache
+  en = writeFrame(frames, irq1_en1);
+  CHECK(en >= 0);
+  CHECK(en < writeFrame(frames, vco_cal_cfg));
+  CHECK_EQ(node.sim.mem(irq1_en1), 0x00);
+  node.radio.cacheEnable(false);
+}
+
+static void send(Node &tx, const uint8_t* payload, uint8_t len) {
+  tx.radio.clearIRQ();
+  tx.radio.writePacket(payload, len);
+  tx.radio.transmit();
+}
+
+int main() {
+  ADF7242Link link(1);
+  Node tx;
+  Node rx;
+  link.attach(tx.sim);
+  link.attach(rx.sim);
+  tx.bringUp(IRQ_TX_PKT_SENT);
+  rx.bringUp(IRQ_RX_PKT_RCVD);
+  rx.radio.receive();
+  CHECK_EQ(rx.sim.state(), ADF7242SIM_RX);
+  CHECK_EQ(rx.bus.digitalRead(RADIO_IRQ), LOW);
+
+  uint8_t buf[ADF7242_MAX_PAYLOAD];
+  CHECK_EQ(rx.radio.serviceIRQ(buf, sizeof(buf)), -1); // Nothing received yet
+  CHECK_EQ(rx.sim.state(), ADF7242SIM_RX); // and RX left alone
+
+  static const uint8_t lengths[] = {1, 88, ADF7242_MAX_PAYLOAD, 17};
+  for (size_t n = 0; n < sizeof(lengths); ++n) {
+    uint8_t payload[ADF7242_MAX_PAYLOAD];
+    for (int i = 0; i < lengths[n]; ++i) {
+      payload[i] = (uint8_t)(i * 29 + n * 7 + 1);
+    }
+    send(tx, payload, lengths[n]);
+    CHECK(waitIRQ(tx, rx, 20000000));
+    CHECK(rx.sim.mem(irq1_src1) & IRQ_RX_PKT_RCVD);
+
+    memset(buf, 0, sizeof(buf));
+    ADF7242RxInfo info;
+    CHECK_EQ(rx.radio.serviceIRQ(buf, sizeof(buf), &info), lengths[n]);
+    CHECK(memcmp(buf, payload, lengths[n]) == 0);
+    CHECK_EQ(rx.sim.mem(irq1_src1), 0); // Every source bit seen was cleared
+    CHECK_EQ(rx.bus.digitalRead(RADIO_IRQ), LOW);
+    CHECK_EQ(rx.sim.state(), ADF7242SIM_RX); // Re-armed for the next packet
+    CHECK_EQ(rx.sim.lastCommand(), RC_RX);
+  }
+  CHECK_EQ(rx.sim.received(), sizeof(lengths));
+  CHECK_EQ(rx.sim.missed(), 0);
+
+  writeBackOrder();
+  return(testResult("adf_irq_test"));
+}
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  quaternion_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  lib/Quaternion against a double precision integration of the same delta angles: after every
+//  update of 100 s of tumbling the attitude stays within tolerance and unit length, the Euler angles
+//  track, the Euler round trip is exact, and rotations too large for the series are clipped in
+//  length about their own axis.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <Quaternion.h>
+#include <math.h>
+
+#define UPDATES 246000 // 100 s at the full output rate
+#define RATE_HZ 2460.0
+#define DELTANG_SCALE (720.0 / 2147483648.0) // deg per DELTANG LSB
+#define EULER_SCALE (180.0 / 32768.0) // deg per Euler LSB
+#define MAX_ERROR_DEG 0.01
+#define MAX_NORM_ERROR 1e-6
+#define MAX_EULER_LSB 6
+
+struct Ref {
+  double w, x, y, z;
+};
+
+static Ref refMultiply(const Ref &a, const Ref &b) {
+  Ref r = {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+           a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+           a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+           a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+  return(r);
+}
+
+// Exact rotation of one sample's delta angles
+static Ref refDelta(const int32_t deltAng[3]) {
+  double v[3];
+  for (int i = 0; i < 3; ++i) {
+    v[i] = deltAng[i] * DELTANG_SCALE * M_PI / 180.0;
+  }
+  double angle = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  double k = angle > 0 ? sin(angle / 2) / angle : 0.5;
+  Ref r = {cos(angle / 2), v[0] * k, v[1] * k, v[2] * k};
+  return(r);
+}
+
+static Ref toRef(const Quaternion &q) {
+  Ref r = {q.w / (double)QUAT_ONE, q.x / (double)QUAT_ONE, q.y / (double)QUAT_ONE, q.z / (double)QUAT_ONE};
+  return(r);
+}
+
+static double norm(const Ref &q) {
+  return(sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z));
+}
+
+// Rotation between two attitudes [deg]
+static double errorDeg(const Ref &a, const Ref &b) {
+  double dot = fabs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z) / (norm(a) * norm(b));
+  return(2 * acos(dot > 1 ? 1 : dot) * 180 / M_PI);
+}
+
+static double angleDiff(double a, double b) {
+  return(fabs(fmod(a - b + 540.0, 360.0) - 180.0));
+}
+
+// The bench's tumbling motion, compared after every update
+static void tumble() {
+  Quaternion q;
+  quatIdentity(q);
+  Ref ref = {1, 0, 0, 0};
+  double maxError = 0;
+  double maxNormError = 0;
+  double maxEulerLsb = 0;
+  double dt = 1.0 / RATE_HZ;
+  for (unsigned long i = 0; i < UPDATES; ++i) {
+    double t = (i + 0.5) * dt;
+    double rate[3] = {200 * sin(2 * M_PI * 0.31 * t) + 40, 150 * cos(2 * M_PI * 0.17 * t + 1), 90 * sin(2 * M_PI * 0.05 * t) + 25};
+    int32_t deltAng[3];
+    for (int a = 0; a < 3; ++a) {
+      deltAng[a] = (int32_t)lround(rate[a] * dt / DELTANG_SCALE);
+    }
+    quatIntegrate(q, deltAng);
+    ref = refMultiply(ref, refDelta(deltAng));
+    double n = norm(ref);
+    ref.w /= n;
+    ref.x /= n;
+    ref.y /= n;
+    ref.z /= n;
+
+    Ref fixed = toRef(q);
+    double error = errorDeg(fixed, ref);
+    maxError = error > maxError ? error : maxError;
+    maxNormError = fabs(norm(fixed) - 1) > maxNormError ? fabs(norm(fixed) - 1) : maxNormError;
+
+    int16_t euler[3];
+    quatToEuler(q, euler);
+    double refAngles[3];
+    refAngles[0] = atan2(2 * (ref.w * ref.x + ref.y * ref.z), 1 - 2 * (ref.x * ref.x + ref.y * ref.y)) * 180 / M_PI;
+    double s = 2 * (ref.w * ref.y - ref.x * ref.z);
+    refAngles[1] = asin(s > 1 ? 1 : (s < -1 ? -1 : s)) * 180 / M_PI;
+    refAngles[2] = atan2(2 * (ref.w * ref.z + ref.x * ref.y), 1 - 2 * (ref.y * ref.y + ref.z * ref.z)) * 180 / M_PI;
+    for (int a = 0; a < 3; ++a) {
+      if (a != 1 && fabs(refAngles[1]) > 85) {
+        continue; // Roll and yaw are ill defined near gimbal lock
+      }
+      double lsb = angleDiff(euler[a] * EULER_SCALE, refAngles[a]) / EULER_SCALE;
+      maxEulerLsb = lsb > maxEulerLsb ? lsb : maxEulerLsb;
+    }
+  }
+  printf("tumble: attitude error %.6f deg, norm error %.2e, Euler error %.2f LSB\n", maxError, maxNormError, maxEulerLsb);
+  CHECK(maxError < MAX_ERROR_DEG);
+  CHECK(maxNormError < MAX_NORM_ERROR);
+  CHECK(maxEulerLsb < MAX_EULER_LSB);
+}
+
+// quatFromEuler() then quatToEuler() gives back the same registers
+static void roundTrip() {
+  int mismatches = 0;
+  for (int r = -32768; r < 32768; r += 997) {
+    for (int p = -16000; p <= 16000; p += 1231) {
+      int16_t in[3] = {(int16_t)r, (int16_t)p, (int16_t)(r * 3 + 12345)};
+      Quaternion q;
+      int16_t out[3];
+      quatFromEuler(in, q);
+      quatToEuler(q, out);
+      for (int a = 0; a < 3; ++a) {
+        mismatches += out[a] != in[a];
+      }
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+}
+
+// Small rotations match the exact one; large ones are 1 rad half angles about their own axis
+static void deltaAngles() {
+  static const int32_t cases[][3] = {
+    {1000000, -2000000, 500000}, // 0.5 deg, well inside the series
+    {300000000, 300000000, 300000000}, // Every axis fits Q30, the length does not
+    {0, 0, 400000000}, // One axis past Q30
+    {2147483647, 2147483647, 2147483647}, // Full scale
+    {-2147483647 - 1, 0, 0},
+    {1000000000, -500000000, 200000000},
+  };
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    Quaternion dq;
+    quatDeltaAngle(cases[c], dq);
+    Ref fixed = toRef(dq);
+    Ref exact = refDelta(cases[c]);
+    double v[3] = {(double)cases[c][0], (double)cases[c][1], (double)cases[c][2]};
+    double length = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    double halfAngle = length * DELTANG_SCALE * M_PI / 360.0;
+    CHECK(fabs(norm(fixed) - 1) < 0.005); // Within what quatNormalize() pulls back
+    if (halfAngle < 0.1) {
+      CHECK(errorDeg(fixed, exact) < 1e-6);
+      continue;
+    }
+    double vecLength = sqrt(fixed.x * fixed.x + fixed.y * fixed.y + fixed.z * fixed.z);
+    double dot = (fixed.x * v[0] + fixed.y * v[1] + fixed.z * v[2]) / (vecLength * length);
+    CHECK(dot > 1 - 1e-9); // Same axis
+    CHECK(fabs(atan2(vecLength, fixed.w) - (halfAngle < 1 ? halfAngle : 1)) < 0.005);
+  }
+
+  // Clipped samples still integrate to a unit quaternion. The series is 0.2% long at 1 rad, which
+  // one Newton step leaves at about 1.5 * 0.002^2.
+  Quaternion q;
+  quatIdentity(q);
+  for (int i = 0; i < 1000; ++i) {
+    quatIntegrate(q, cases[3 + i % 3]);
+  }
+  CHECK(fabs(norm(toRef(q)) - 1) < 1e-5);
+}
+
+int main() {
+  tumble();
+  roundTrip();
+  deltaAngles();
+  return(testResult("quaternion_test"));
+}
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  sample_log_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SampleLogWriter/SampleLogReader across a micros() wrap and a transmitter restart: time in the file
+//  keeps increasing, find() lands on the right chunk on either side, the original 32 bit timestamps
+//  come back, and range() refuses chunks and columns that are not there.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <SampleLog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#define CHUNK_ROWS 16
+#define PERIOD_US 500
+
+int main() {
+  char path[] = "/tmp/sample_log_testXXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  close(fd);
+
+  // Runs up to a wrap, past it, then the transmitter restarts and micros() starts again near zero
+  std::vector<uint32_t> stamps;
+  for (uint32_t i = 0; i < 40; ++i) {
+    stamps.push_back(0xFFFFF000UL + i * PERIOD_US);
+  }
+  for (uint32_t i = 0; i < 40; ++i) {
+    stamps.push_back(1000000UL + i * PERIOD_US);
+  }
+  uint32_t wrapped = stamps.back();
+  CHECK(wrapped < 0x80000000UL); // Less than 2^31 below what came before, so not a wrap
+  for (uint32_t i = 0; i < 40; ++i) {
+    stamps.push_back(2000000UL + i * PERIOD_US);
+  }
+
+  SampleLogWriter writer;
+  CHECK(writer.open(path, CHUNK_ROWS));
+  for (size_t i = 0; i < stamps.size(); ++i) {
+    ADIS16480Sample s;
+    memset(&s, 0, sizeof(s));
+    s.timestamp = stamps[i];
+    s.seqCnt = (uint16_t)i;
+    CHECK(writer.append(s));
+  }
+  CHECK(writer.close());
+
+  SampleLogReader reader;
+  CHECK(reader.open(path));
+  CHECK_EQ(reader.rows(), stamps.size());
+  std::vector<SampleLogRecord> rows;
+  for (size_t i = 0; i < reader.chunks(); ++i) {
+    CHECK(reader.read(i, rows));
+    if (i > 0) {
+      CHECK(reader.chunk(i).minTime > reader.chunk(i - 1).maxTime);
+    }
+  }
+  CHECK_EQ(rows.size(), stamps.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    CHECK_EQ(rows[i].sample.timestamp, stamps[i]);
+    CHECK_EQ(rows[i].sample.seqCnt, i);
+    if (i > 0) {
+      CHECK(rows[i].time > rows[i - 1].time);
+    }
+  }
+
+  // Every row is found through the index, before and after the restart
+  for (size_t i = 0; i < rows.size(); ++i) {
+    size_t c = reader.find(rows[i].time);
+    CHECK(c < reader.chunks());
+    CHECK(rows[i].time >= reader.chunk(c).minTime && rows[i].time <= reader.chunk(c).maxTime);
+  }
+  std::vector<SampleLogRecord> window;
+  CHECK_EQ(reader.read(rows[100].time, rows[104].time, window), 5);
+  CHECK_EQ(window.front().sample.seqCnt, 100);
+
+  int64_t min = 0;
+  int64_t max = 0;
+  CHECK(reader.range(0, SAMPLELOG_SEQ_CNT, min, max));
+  CHECK_EQ(min, 0);
+  CHECK_EQ(max, CHUNK_ROWS - 1);
+  CHECK(!reader.range(reader.chunks(), SAMPLELOG_SEQ_CNT, min, max));
+  CHECK(!reader.range(0, SAMPLELOG_COLUMNS, min, max));
+  CHECK(!reader.range(0, -1, min, max));
+  reader.close();
+  unlink(path);
+  return(testResult("sample_log_test"));
+}
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  sample_queue_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SampleQueue with a producer thread standing in for the data ready ISR: items come out intact and
+//  in order, exactly the items refused by push() are missing, and overflows() and highWater() agree
+//  with what the producer saw.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <SampleQueue.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define QUEUE_DEPTH 16
+#define ITEMS 2000000
+#define PAUSE_EVERY 200000 // Consumer stalls now and then so the queue overflows
+
+// Large enough that a torn copy would show
+struct Item {
+  uint32_t seq;
+  uint32_t check[15];
+};
+
+static void fill(Item &item, uint32_t seq) {
+  item.seq = seq;
+  for (int i = 0; i < 15; ++i) {
+    item.check[i] = (uint32_t)(seq * 2654435761UL + i);
+  }
+}
+
+static bool intact(const Item &item) {
+  for (int i = 0; i < 15; ++i) {
+    if (item.check[i] != (uint32_t)(item.seq * 2654435761UL + i)) {
+      return(false);
+    }
+  }
+  return(true);
+}
+
+// Single threaded edges: full, overflow, FIFO order, and wrap of the indices
+static void edges() {
+  SampleQueue<Item, 4> q;
+  Item item;
+  CHECK(!q.pop(item));
+  for (uint32_t round = 0; round < 3; ++round) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      fill(item, round * 10 + i);
+      CHECK(q.push(item));
+    }
+    fill(item, 99);
+    CHECK(!q.push(item));
+    CHECK_EQ(q.size(), 4);
+    for (uint32_t i = 0; i < 4; ++i) {
+      CHECK(q.pop(item));
+      CHECK_EQ(item.seq, round * 10 + i);
+    }
+    CHECK(!q.pop(item));
+  }
+  CHECK_EQ(q.overflows(), 3);
+  CHECK_EQ(q.highWater(), 4);
+}
+
+// Producer and consumer on two threads
+static void concurrent() {
+  static SampleQueue<Item, QUEUE_DEPTH> q;
+  std::vector<uint32_t> refused; // Owned by the producer until join()
+  uint16_t highWaterSeen = 0;
+  bool done = false;
+
+  std::thread producer([&]() {
+    Item item;
+    for (uint32_t seq = 0; seq < ITEMS; ++seq) {
+      fill(item, seq);
+      if (!q.push(item)) {
+        refused.push_back(seq);
+      }
+      uint16_t depth = q.size();
+      highWaterSeen = depth > highWaterSeen ? depth : highWaterSeen;
+    }
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  });
+
+  std::vector<uint32_t> missing;
+  uint32_t popped = 0;
+  uint32_t next = 0; // Next sequence number expected
+  unsigned long torn = 0;
+  unsigned long backwards = 0;
+  Item item;
+  for (;;) {
+    bool finished = __atomic_load_n(&done, __ATOMIC_ACQUIRE); // Checked before pop() so nothing is left behind
+    if (!q.pop(item)) {
+      if (finished) {
+        break;
+      }
+      continue;
+    }
+    ++popped;
+    torn += !intact(item);
+    if (item.seq < next) {
+      ++backwards;
+    }
+    for (; next < item.seq; ++next) {
+      missing.push_back(next);
+    }
+    next = item.seq + 1;
+    if (popped % PAUSE_EVERY == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+  }
+  producer.join();
+  for (; next < ITEMS; ++next) {
+    missing.push_back(next);
+  }
+
+  CHECK_EQ(torn, 0);
+  CHECK_EQ(backwards, 0);
+  CHECK_EQ(popped + refused.size(), ITEMS);
+  CHECK_EQ(q.overflows(), refused.size());
+  CHECK(missing == refused); // Exactly the refused items are gone, nothing else
+  CHECK(refused.size() > 0); // The consumer pauses make sure overflow was exercised
+  CHECK_EQ(q.highWater(), QUEUE_DEPTH); // Reached whenever a push was refused
+  CHECK(highWaterSeen <= QUEUE_DEPTH);
+}
+
+int main() {
+  edges();
+  concurrent();
+  return(testResult("sample_queue_test"));
+}
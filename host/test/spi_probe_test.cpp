@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  spi_probe_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SPIBus::probe() against a simulated ADIS16480 that handles at most 6 MHz and a simulated ADF7242
+//  that handles at most 8 MHz, sharing one bus as on the TX board. Each probe keeps exactly the
+//  device's limit, and no frame clocked at a trial rate writes anything.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <HostSPITransport.h>
+#include <SPIBus.h>
+#include <ADIS16480.h>
+#include <ADF7242.h>
+#include <ADIS16480Sim.h>
+#include <ADF7242Sim.h>
+
+#define IMU_CS 10
+#define IMU_DR 8
+#define IMU_RST 6
+#define RADIO_CS 7
+#define RADIO_IRQ 2
+#define IMU_MAX_CLOCK 6000000
+#define RADIO_MAX_CLOCK 8000000
+#define SOAK 50
+
+// The TX sketch's candidate rates
+static const uint32_t probeClocks[] = {1000000, 2000000, 4000000, 6000000, 8000000, 12000000, 15000000};
+static const int probeCount = sizeof(probeClocks) / sizeof(probeClocks[0]);
+
+struct Board {
+  HostSPITransport bus;
+  SPIBus spiBus;
+  ADIS16480Sim imuSim;
+  ADF7242Sim radioSim;
+  ADIS16480 imu;
+  ADF7242 radio;
+  int imuBus;
+  int radioBus;
+
+  Board() : spiBus(bus), imuSim(IMU_RST), radioSim(RADIO_IRQ), imu(IMU_CS, IMU_DR, IMU_RST, bus), radio(RADIO_CS, bus) {
+    bus.setRecording(false);
+    bus.attach(IMU_CS, &imuSim, IMU_MAX_CLOCK);
+    bus.attachPin(IMU_DR, &imuSim);
+    bus.attachPin(IMU_RST, &imuSim);
+    bus.attach(RADIO_CS, &radioSim, RADIO_MAX_CLOCK);
+    bus.attachPin(RADIO_IRQ, &radioSim);
+    imuBus = spiBus.addDevice(ADIS16480_SPI_CLOCK, MSBFIRST, ADIS16480_SPI_MODE);
+    radioBus = spiBus.addDevice(ADF7242_SPI_CLOCK, MSBFIRST, ADF7242_SPI_MODE);
+    spiBus.setClock(imuBus, SPIBUS_DATA, ADIS16480_SPI_DATA_CLOCK);
+    spiBus.setClock(radioBus, SPIBUS_DATA, ADF7242_SPI_DATA_CLOCK);
+  }
+};
+
+static bool imuLinkCheck(void* arg) {
+  return(((Board*)arg)->imu.linkCheck());
+}
+
+static bool radioLinkCheck(void* arg) {
+  return(((Board*)arg)->radio.linkCheck());
+}
+
+// Frames to cs clocked above the configuration rate that carry a write command
+static int trialWrites(const std::vector<SPIFrame> &frames, int cs, uint32_t configClock) {
+  int writes = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const SPIFrame &f = frames[i];
+    if (f.cs != cs || f.clock <= configClock || f.mosi.empty()) {
+      continue;
+    }
+    uint8_t op = f.mosi[0];
+    if (cs == IMU_CS ? (op & 0x80) != 0 : ((op & 0xF8) == SPI_MEM_WR || (op & 0xF8) == SPI_MEMR_WR)) {
+      ++writes;
+    }
+  }
+  return(writes);
+}
+
+int main() {
+  Board board;
+
+  // Radio configuration as in the TX sketch, so sync_word0..2 hold the pattern linkCheck() reads
+  board.spiBus.begin(board.radioBus);
+  board.radio.configSPI();
+  board.radio.reset();
+  board.radio.idle();
+  board.radio.syncWord(0x00, 0x00);
+  board.spiBus.end();
+
+  // linkCheck() refuses to select the page itself
+  board.spiBus.begin(board.imuBus);
+  board.imu.regRead(DEC_RATE); // Leaves the sensor on page 3
+  uint64_t frames = board.bus.stats().frames;
+  CHECK(!board.imu.linkCheck());
+  CHECK_EQ(board.bus.stats().frames, frames);
+  board.imu.regRead(PROD_ID); // Page 0, at the configuration clock
+  board.spiBus.end();
+
+  board.bus.setRecording(true);
+  CHECK_EQ(board.spiBus.probe(board.imuBus, imuLinkCheck, &board, probeClocks, probeCount, SOAK), IMU_MAX_CLOCK);
+  CHECK_EQ(board.spiBus.probe(board.radioBus, radioLinkCheck, &board, probeClocks, probeCount, SOAK), RADIO_MAX_CLOCK);
+  CHECK_EQ(board.spiBus.clock(board.imuBus, SPIBUS_DATA), IMU_MAX_CLOCK);
+  CHECK_EQ(board.spiBus.clock(board.radioBus, SPIBUS_DATA), RADIO_MAX_CLOCK);
+  CHECK_EQ(board.spiBus.clock(board.imuBus, SPIBUS_CONFIG), ADIS16480_SPI_CLOCK);
+  CHECK_EQ(board.spiBus.clock(board.radioBus, SPIBUS_CONFIG), ADF7242_SPI_CLOCK);
+
+  // Every rate up to the limit soaked, the next one failed, and nothing was written on the way
+  const std::vector<SPIFrame> &recorded = board.bus.frames();
+  CHECK(!recorded.empty());
+  CHECK_EQ(trialWrites(recorded, IMU_CS, ADIS16480_SPI_CLOCK), 0);
+  CHECK_EQ(trialWrites(recorded, RADIO_CS, ADF7242_SPI_CLOCK), 0);
+  CHECK_EQ(board.imuSim.reg(PAGE_ID), 0);
+  CHECK_EQ(board.radioSim.mem(sync_word0), 0x31);
+
+  // A device that fails at every rate keeps its data clock
+  HostSPITransport slowBus;
+  SPIBus slowSpi(slowBus);
+  ADIS16480Sim slowSim(IMU_RST);
+  ADIS16480 slowImu(IMU_CS, IMU_DR, IMU_RST, slowBus);
+  slowBus.setRecording(false);
+  slowBus.attach(IMU_CS, &slowSim, 500000);
+  int slow = slowSpi.addDevice(ADIS16480_SPI_CLOCK, MSBFIRST, ADIS16480_SPI_MODE);
+  slowSpi.setClock(slow, SPIBUS_DATA, ADIS16480_SPI_DATA_CLOCK);
+  struct Slow {
+    static bool check(void* arg) { return(((ADIS16480*)arg)->linkCheck()); }
+  };
+  CHECK_EQ(slowSpi.probe(slow, Slow::check, &slowImu, probeClocks, probeCount, SOAK), 0);
+  CHECK_EQ(slowSpi.clock(slow, SPIBUS_DATA), ADIS16480_SPI_DATA_CLOCK);
+  return(testResult("spi_probe_test"));
+}
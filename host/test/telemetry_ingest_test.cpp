@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  telemetry_ingest_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  TelemetryIngest reading a pseudo-terminal in 64 byte chunks, so nearly every frame straddles two
+//  reads and its tail is carried over. The stream holds good sample frames, a noise burst, an
+//  overlong run that spans several reads, a frame with a flipped bit, a TELEM_BATCH frame, and a
+//  sequence gap. Every good record must arrive intact and in order, and every error counter must
+//  come out exact.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <TelemetryIngest.h>
+#include <ADIS16480.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define CHUNK 64
+#define BATCH_RECORDS 11
+#define OVERLONG 700 // Bytes without a delimiter, several chunks and more than any legal frame
+#define LAST_SEQ 22
+
+static ADIS16480Sample sampleFor(uint16_t seq) {
+  ADIS16480Sample s;
+  uint8_t* p = (uint8_t*)&s;
+  for (size_t i = 0; i < sizeof(s); ++i) {
+    p[i] = (uint8_t)(seq * 31 + i * 7); // Zeros included, so the stuffing has work to do
+  }
+  s.timestamp = 1000000UL + seq * 406;
+  return(s);
+}
+
+static TelemetryTimedAttitude recordFor(int i) {
+  TelemetryTimedAttitude r;
+  r.timestamp = 5000000UL + i * 406;
+  r.roll = (int16_t)(i * 300);
+  r.pitch = (int16_t)(-i * 200);
+  r.yaw = (int16_t)(i * 1000);
+  return(r);
+}
+
+static void appendSample(std::vector<uint8_t> &stream, uint16_t seq) {
+  ADIS16480Sample s = sampleFor(seq);
+  uint8_t enc[TELEMETRY_MAX_ENCODED];
+  size_t n = telemetryEncode(TELEM_SAMPLE, seq, (const uint8_t*)&s, sizeof(s), enc, sizeof(enc));
+  stream.insert(stream.end(), enc, enc + n);
+}
+
+struct Received {
+  std::vector<uint16_t> sampleSeqs;
+  int corruptSamples;
+  int batches;
+  int batchMismatches;
+};
+
+static void onSpan(const TelemetrySpan &span, void* arg) {
+  Received* r = (Received*)arg;
+  if (span.type == TELEM_SAMPLE) {
+    ADIS16480Sample s = sampleFor(span.seq);
+    r->sampleSeqs.push_back(span.seq);
+    r->corruptSamples += span.size != sizeof(s) || span.count != 1 || memcmp(span.data, &s, sizeof(s)) != 0;
+  }
+  else if (span.type == TELEM_TIMED_ATTITUDE) {
+    ++r->batches;
+    r->batchMismatches += span.seq != 16 || span.size != sizeof(TelemetryTimedAttitude) || span.count != BATCH_RECORDS;
+    for (int i = 0; i < span.count && i < BATCH_RECORDS; ++i) {
+      TelemetryTimedAttitude rec = recordFor(i);
+      r->batchMismatches += memcmp(span.data + i * span.size, &rec, sizeof(rec)) != 0;
+    }
+  }
+}
+
+int main() {
+  // Good frames 0..9, noise, 10..14, an overlong run, 15 with a bit flipped, a batch as 16,
+  // 17..19, then 20 and 21 never sent, and 22
+  std::vector<uint8_t> stream;
+  std::vector<uint16_t> expected;
+  for (uint16_t seq = 0; seq < 10; ++seq) {
+    appendSample(stream, seq);
+    expected.push_back(seq);
+  }
+  static const uint8_t noise[] = {0x05, 0x11, 0x22, 0x00}; // A code byte promising more than follows
+  stream.insert(stream.end(), noise, noise + sizeof(noise));
+  for (uint16_t seq = 10; seq < 15; ++seq) {
+    appendSample(stream, seq);
+    expected.push_back(seq);
+  }
+  stream.insert(stream.end(), OVERLONG, 0x55);
+  stream.push_back(0x00);
+  size_t flipped = stream.size() + 20; // A data byte of frame 15
+  appendSample(stream, 15);
+  stream[flipped] ^= 0x04;
+  CHECK(stream[flipped] != 0x00);
+
+  TelemetryBatch batch(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), BATCH_RECORDS, 0xFFFFFFFFUL);
+  for (int i = 0; i < BATCH_RECORDS; ++i) {
+    TelemetryTimedAttitude rec = recordFor(i);
+    CHECK_EQ(batch.add(&rec, 0), i + 1 == BATCH_RECORDS);
+  }
+  uint8_t enc[TELEMETRY_MAX_ENCODED];
+  size_t n = batch.encode(16, enc, sizeof(enc));
+  stream.insert(stream.end(), enc, enc + n);
+  for (uint16_t seq = 17; seq < 20; ++seq) {
+    appendSample(stream, seq);
+    expected.push_back(seq);
+  }
+  appendSample(stream, LAST_SEQ);
+  expected.push_back(LAST_SEQ);
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0);
+  TelemetryIngest ingest(CHUNK);
+  CHECK(ingest.open(ptsname(master))); // Raw mode before the first byte is written
+  Received received = {std::vector<uint16_t>(), 0, 0, 0};
+  ingest.subscribe(TELEMETRY_ANY, onSpan, &received);
+
+  // The writer goes in small pieces, as a USB serial port would deliver them
+  std::thread writer([&]() {
+    for (size_t pos = 0; pos < stream.size(); ) {
+      size_t piece = stream.size() - pos < 37 ? stream.size() - pos : 37;
+      ssize_t written = write(master, &stream[pos], piece);
+      if (written < 0 && errno != EINTR && errno != EAGAIN) {
+        return;
+      }
+      pos += written > 0 ? written : 0;
+    }
+  });
+  int reads = 0;
+  while (received.sampleSeqs.empty() || received.sampleSeqs.back() != LAST_SEQ) {
+    long got = ingest.poll(2000);
+    if (got <= 0) {
+      break; // Timed out: the checks below report what is missing
+    }
+    CHECK(got <= CHUNK);
+    ++reads;
+  }
+  writer.join();
+  ingest.close();
+  close(master);
+
+  CHECK(reads >= (int)(stream.size() / CHUNK));
+  CHECK(received.sampleSeqs == expected);
+  CHECK_EQ(received.corruptSamples, 0);
+  CHECK_EQ(received.batches, 1);
+  CHECK_EQ(received.batchMismatches, 0);
+
+  TelemetryIngestStats stats = ingest.stats();
+  CHECK_EQ(stats.bytes, stream.size());
+  CHECK_EQ(stats.frames, expected.size() + 1);
+  CHECK_EQ(stats.records, expected.size() + BATCH_RECORDS);
+  CHECK_EQ(stats.bad[TELEMETRY_BAD_COBS], 1); // The noise burst
+  CHECK_EQ(stats.bad[TELEMETRY_BAD_CRC], 1); // Frame 15
+  CHECK_EQ(stats.bad[TELEMETRY_BAD_LENGTH], 0);
+  CHECK_EQ(stats.bad[TELEMETRY_BAD_VERSION], 0);
+  CHECK_EQ(stats.overlong, 1);
+  CHECK_EQ(stats.resyncs, 3);
+  CHECK_EQ(stats.lost, 3); // 15, 20, and 21
+  return(testResult("telemetry_ingest_test"));
+}
@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host test, standard C++11
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  telemetry_test.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  The COBS + CRC-16 frame codec: every payload length round trips and matches a plain reference
+//  COBS encoder byte for byte, the CRC gives the CRC-16/CCITT-FALSE check value, damaged frames are
+//  rejected with the right status, and an output buffer one byte short is refused. TelemetryBatch
+//  fills radio sized frames, reports full and due (across a micros() wrap), and empties on encode,
+//  and telemetryBatchRecords() hands back exactly the records that went in.
+//
+//  A raw frame is at most TELEMETRY_MAX_RAW (247) bytes, so telemetryEncode() never fills a
+//  254 byte COBS block. The decoder is still fed runs of 253, 254, and 255 nonzero bytes built by
+//  the reference encoder, since it accepts any length the header agrees with.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HostTest.h"
+#include <Telemetry.h>
+#include <ADF7242.h>
+#include <string.h>
+#include <vector>
+
+// Textbook COBS, 0x00 delimiter appended
+static std::vector<uint8_t> cobs(const std::vector<uint8_t> &raw) {
+  std::vector<uint8_t> out(1, 0);
+  size_t code = 0;
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != 0) {
+      out.push_back(raw[i]);
+    }
+    if (raw[i] == 0 || out.size() - code == 0xFF) {
+      out[code] = (uint8_t)(out.size() - code);
+      code = out.size();
+      out.push_back(0);
+    }
+  }
+  out[code] = (uint8_t)(out.size() - code);
+  out.push_back(0x00);
+  return(out);
+}
+
+// Unstuffed frame: header, payload, CRC
+static std::vector<uint8_t> rawFrame(uint8_t version, uint8_t type, uint16_t seq, const std::vector<uint8_t> &payload) {
+  std::vector<uint8_t> raw;
+  raw.push_back(version);
+  raw.push_back(type);
+  raw.push_back((uint8_t)(seq & 0xFF));
+  raw.push_back((uint8_t)(seq >> 8));
+  raw.push_back((uint8_t)payload.size());
+  raw.insert(raw.end(), payload.begin(), payload.end());
+  uint16_t crc = telemetryCRC(raw.data(), raw.size());
+  raw.push_back((uint8_t)(crc & 0xFF));
+  raw.push_back((uint8_t)(crc >> 8));
+  return(raw);
+}
+
+// Decode an encoded frame including its delimiter
+static TelemetryStatus decode(std::vector<uint8_t> enc, TelemetryFrame &frame, std::vector<uint8_t> &payload) {
+  TelemetryStatus status = telemetryDecode(enc.data(), enc.size() - 1, frame);
+  if (status == TELEMETRY_OK) {
+    payload.assign(frame.payload, frame.payload + frame.length);
+  }
+  return(status);
+}
+
+static void crcCheckValue() {
+  CHECK_EQ(telemetryCRC((const uint8_t*)"123456789", 9), 0x29B1);
+  CHECK_EQ(telemetryCRC((const uint8_t*)"56789", 5, telemetryCRC((const uint8_t*)"1234", 4)), 0x29B1);
+}
+
+// Every length with three fills: counting (zeros inside), all 0x00, and all 0xFF
+static void roundTrip() {
+  for (int fill = 0; fill < 3; ++fill) {
+    for (int len = 0; len <= TELEMETRY_MAX_PAYLOAD; ++len) {
+      std::vector<uint8_t> payload(len);
+      for (int i = 0; i < len; ++i) {
+        payload[i] = fill == 0 ? (uint8_t)i : (fill == 1 ? 0x00 : 0xFF);
+      }
+      uint16_t seq = (uint16_t)(0x0101 * (len + 1));
+      uint8_t enc[TELEMETRY_MAX_ENCODED];
+      size_t n = telemetryEncode(TELEM_SAMPLE, seq, payload.data(), (uint8_t)len, enc, sizeof(enc));
+      CHECK(n > 0 && n <= (size_t)TELEMETRY_ENCODED_SIZE(len));
+      CHECK_EQ(enc[n - 1], 0x00);
+      CHECK(memchr(enc, 0, n - 1) == 0);
+
+      std::vector<uint8_t> expected = cobs(rawFrame(TELEMETRY_VERSION, TELEM_SAMPLE, seq, payload));
+      CHECK(expected.size() == n && memcmp(expected.data(), enc, n) == 0);
+
+      TelemetryFrame frame;
+      std::vector<uint8_t> out;
+      CHECK_EQ(decode(std::vector<uint8_t>(enc, enc + n), frame, out), TELEMETRY_OK);
+      CHECK_EQ(frame.version, TELEMETRY_VERSION);
+      CHECK_EQ(frame.type, TELEM_SAMPLE);
+      CHECK_EQ(frame.seq, seq);
+      CHECK_EQ(frame.length, len);
+      CHECK(out == payload);
+
+      // One byte short is refused, the exact size is enough
+      uint8_t small[TELEMETRY_MAX_ENCODED];
+      CHECK_EQ(telemetryEncode(TELEM_SAMPLE, seq, payload.data(), (uint8_t)len, small, n - 1), 0);
+      CHECK_EQ(telemetryEncode(TELEM_SAMPLE, seq, payload.data(), (uint8_t)len, small, n), n);
+    }
+  }
+  uint8_t payload[TELEMETRY_MAX_PAYLOAD + 1] = {0};
+  uint8_t enc[TELEMETRY_MAX_ENCODED + 8];
+  CHECK_EQ(telemetryEncode(TELEM_SAMPLE, 0, payload, TELEMETRY_MAX_PAYLOAD + 1, enc, sizeof(enc)), 0);
+}
+
+// Nonzero runs across the 254 byte COBS block boundary, decoded
+static void blockBoundary() {
+  static const int runs[] = {253, 254, 255};
+  for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); ++r) {
+    // version, type, seq, length, and the CRC are all nonzero here, so the run covers the frame
+    std::vector<uint8_t> payload(runs[r] - TELEMETRY_HEADER - TELEMETRY_CRC);
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] = (uint8_t)(i % 255 + 1);
+    }
+    std::vector<uint8_t> raw;
+    uint16_t seq = 0x0101;
+    for (; seq < 0xFFFF; ++seq) {
+      raw = rawFrame(TELEMETRY_VERSION, TELEM_SAMPLE, seq, payload);
+      if ((seq & 0xFF) && (seq >> 8) && raw[raw.size() - 2] && raw[raw.size() - 1]) {
+        break;
+      }
+    }
+    CHECK(memchr(raw.data(), 0, raw.size()) == 0);
+    CHECK_EQ(raw.size(), runs[r]);
+    TelemetryFrame frame;
+    std::vector<uint8_t> out;
+    CHECK_EQ(decode(cobs(raw), frame, out), TELEMETRY_OK);
+    CHECK_EQ(frame.seq, seq);
+    CHECK(out == payload);
+  }
+}
+
+// Damaged frames come back with the reason
+static void rejects() {
+  uint8_t payload[40];
+  for (int i = 0; i < 40; ++i) {
+    payload[i] = (uint8_t)(i * 7);
+  }
+  uint8_t enc[TELEMETRY_MAX_ENCODED];
+  size_t n = telemetryEncode(TELEM_SAMPLE, 1234, payload, sizeof(payload), enc, sizeof(enc));
+  std::vector<uint8_t> good(enc, enc + n);
+  TelemetryFrame frame;
+  std::vector<uint8_t> out;
+
+  // A flipped payload bit, wherever it lands, as long as it leaves the stuffing alone
+  int badCrc = 0;
+  for (size_t i = 0; i + 1 < n; ++i) {
+    for (int bit = 0; bit < 8; ++bit) {
+      std::vector<uint8_t> flipped = good;
+      flipped[i] ^= (uint8_t)(1 << bit);
+      TelemetryStatus status = decode(flipped, frame, out);
+      CHECK(status != TELEMETRY_OK);
+      badCrc += status == TELEMETRY_BAD_CRC;
+    }
+  }
+  CHECK(badCrc > 0);
+  std::vector<uint8_t> flipped = good;
+  flipped[10] ^= 0x01; // A data byte, not a code byte
+  CHECK(flipped[10] != 0);
+  CHECK_EQ(decode(flipped, frame, out), TELEMETRY_BAD_CRC);
+
+  // Truncated anywhere
+  for (size_t cut = 1; cut + 1 < n; ++cut) {
+    std::vector<uint8_t> truncated(good.begin(), good.begin() + cut);
+    truncated.push_back(0x00);
+    TelemetryStatus status = decode(truncated, frame, out);
+    CHECK(status == TELEMETRY_BAD_COBS || status == TELEMETRY_BAD_LENGTH);
+  }
+  std::vector<uint8_t> empty(1, 0x00);
+  CHECK_EQ(decode(empty, frame, out), TELEMETRY_BAD_LENGTH);
+
+  // Another firmware's version, with a valid CRC
+  std::vector<uint8_t> raw = rawFrame(TELEMETRY_VERSION + 1, TELEM_SAMPLE, 1234,
+                                      std::vector<uint8_t>(payload, payload + sizeof(payload)));
+  CHECK_EQ(decode(cobs(raw), frame, out), TELEMETRY_BAD_VERSION);
+}
+
+#define RADIO_ENCODED (ADF7242_MAX_PAYLOAD + 1) // One radio packet plus the delimiter that is not sent
+#define DEADLINE_US 20000
+
+static TelemetryTimedAttitude record(uint32_t i) {
+  TelemetryTimedAttitude r;
+  r.timestamp = 0x12345678UL + i * 406;
+  r.roll = (int16_t)(i * 101);
+  r.pitch = (int16_t)(-(int32_t)i * 57);
+  r.yaw = (int16_t)(i * 3001);
+  return(r);
+}
+
+static void batching() {
+  // fit() is the most that still fits a radio packet
+  uint8_t fits = TelemetryBatch::fit(sizeof(TelemetryTimedAttitude), RADIO_ENCODED);
+  CHECK(fits > 0);
+  CHECK((size_t)TELEMETRY_ENCODED_SIZE(TELEMETRY_BATCH_HEADER + fits * sizeof(TelemetryTimedAttitude)) <= RADIO_ENCODED);
+  CHECK((size_t)TELEMETRY_ENCODED_SIZE(TELEMETRY_BATCH_HEADER + (fits + 1) * sizeof(TelemetryTimedAttitude)) > RADIO_ENCODED);
+  TelemetryBatch clipped(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), 255, DEADLINE_US, RADIO_ENCODED);
+  CHECK_EQ(clipped.capacity(), fits);
+
+  // Full at maxRecords, with a frame that really fits one packet
+  TelemetryBatch batch(TELEM_TIMED_ATTITUDE, sizeof(TelemetryTimedAttitude), fits, DEADLINE_US, RADIO_ENCODED);
+  for (uint8_t i = 0; i < fits; ++i) {
+    TelemetryTimedAttitude r = record(i);
+    CHECK_EQ(batch.add(&r, 1000 + i), i + 1 == fits);
+  }
+  CHECK_EQ(batch.count(), fits);
+  uint8_t enc[TELEMETRY_MAX_ENCODED];
+  size_t n = batch.encode(77, enc, RADIO_ENCODED);
+  CHECK(n > 0 && n <= RADIO_ENCODED);
+  CHECK_EQ(batch.count(), 0); // encode() empties the batch
+  CHECK_EQ(batch.encode(78, enc, sizeof(enc)), 0);
+  CHECK(!batch.due(0xFFFFFFFFUL));
+
+  // The records come back as sent
+  TelemetryFrame frame;
+  CHECK_EQ(telemetryDecode(enc, n - 1, frame), TELEMETRY_OK);
+  CHECK_EQ(frame.type, TELEM_BATCH);
+  CHECK_EQ(frame.seq, 77);
+  uint8_t recordType = 0;
+  uint8_t recordSize = 0;
+  const uint8_t* records = 0;
+  CHECK_EQ(telemetryBatchRecords(frame, recordType, recordSize, records), fits);
+  CHECK_EQ(recordType, TELEM_TIMED_ATTITUDE);
+  CHECK_EQ(recordSize, sizeof(TelemetryTimedAttitude));
+  for (uint8_t i = 0; i < fits; ++i) {
+    TelemetryTimedAttitude r = record(i);
+    CHECK(memcmp(records + i * recordSize, &r, sizeof(r)) == 0);
+  }
+
+  // A length that is not a whole number of records is rejected, so is a zero record size
+  TelemetryFrame bad = frame;
+  bad.length = (uint8_t)(frame.length - 1);
+  CHECK_EQ(telemetryBatchRecords(bad, recordType, recordSize, records), 0);
+  uint8_t zeroSize[TELEMETRY_BATCH_HEADER + 4] = {TELEM_TIMED_ATTITUDE, 0};
+  bad.payload = zeroSize;
+  bad.length = sizeof(zeroSize);
+  CHECK_EQ(telemetryBatchRecords(bad, recordType, recordSize, records), 0);
+  bad.length = 1;
+  CHECK_EQ(telemetryBatchRecords(bad, recordType, recordSize, records), 0);
+  bad = frame;
+  bad.type = TELEM_SAMPLE;
+  CHECK_EQ(telemetryBatchRecords(bad, recordType, recordSize, records), 0);
+
+  // The deadline, counted from the oldest record, also across a micros() wrap
+  static const uint32_t starts[] = {1000, 0xFFFFFFFFUL - DEADLINE_US / 2};
+  for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); ++s) {
+    uint32_t t0 = starts[s];
+    TelemetryTimedAttitude r = record(0);
+    CHECK(!batch.add(&r, t0));
+    CHECK(!batch.add(&r, t0 + DEADLINE_US / 2));
+    CHECK(!batch.due(t0 + DEADLINE_US - 1));
+    CHECK(batch.due(t0 + DEADLINE_US));
+    CHECK(batch.add(&r, t0 + DEADLINE_US));
+    CHECK_EQ(batch.count(), 3);
+    CHECK(batch.encode(0, enc, sizeof(enc)) > 0);
+    CHECK(!batch.due(t0 + DEADLINE_US));
+  }
+}
+
+int main() {
+  crcCheckValue();
+  roundTrip();
+  blockBoundary();
+  rejects();
+  batching();
+  return(testResult("telemetry_test"));
+}
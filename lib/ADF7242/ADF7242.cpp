@@ -24,21 +24,78 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-#include "Arduino.h"
-#include <SPI.h>
 #include "ADF7242.h"
+#include <Profiler.h>
+
+// Hot path probes, compiled out unless PROFILE is defined in Profiler.h
+PROFILE_PROBE(regReadProbe, "ADF7242::regRead");
+PROFILE_PROBE(regWriteProbe, "ADF7242::regWrite");
+PROFILE_PROBE(writePacketProbe, "ADF7242::writePacket");
+PROFILE_PROBE(readPacketProbe, "ADF7242::readPacket");
+PROFILE_PROBE(transmitProbe, "ADF7242::transmit");
+
+// Table 50 register map in address order. Shared by the shadow register cache and dumpRegMap().
+static constexpr unsigned int regMap[ADF7242_MAP_SIZE] = {
+  0x100, 0x102, 0x105, 0x106, 0x107, 0x108, 0x109, 0x10A, 0x10B, 0x10C, 0x10D, 0x10E, 0x10F,
+  0x111, 0x13E, 0x300, 0x301, 0x302, 0x304, 0x305, 0x306, 0x30C, 0x30D, 0x30E, 0x30F, 0x313, 0x314, 0x315,
+  0x316, 0x317, 0x318, 0x319, 0x31A, 0x31B, 0x31E, 0x32C, 0x32D, 0x335, 0x33D, 0x353, 0x354, 0x355, 0x36E,
+  0x36F, 0x371, 0x380, 0x381, 0x389, 0x38B, 0x395, 0x396, 0x39B, 0x3A7, 0x3A8, 0x3A9, 0x3AA, 0x3AE, 0x3B2,
+  0x3B4, 0x3B6, 0x3B7, 0x3B8, 0x3B9, 0x3BA, 0x3BC, 0x3BF, 0x3C4, 0x3C7, 0x3C8, 0x3C9, 0x3CA, 0x3CB, 0x3CC,
+  0x3D2, 0x3D3, 0x3D4, 0x3D5, 0x3D6, 0x3D7, 0x3E0, 0x3E3, 0x3E6, 0x3F0, 0x3F3, 0x3F4, 0x3F7, 0x3F8, 0x3F9,
+  0x3FA};
+
+// Registers that change on their own, clear on write, or trigger an action when written. They never
+// read back as written and are never cached.
+static bool volatileReg(unsigned int regAddr) {
+  return(regAddr == rrb || regAddr == lrb || regAddr == irq1_src0 || regAddr == irq1_src1
+    || regAddr == afc_read || regAddr == adc_rbk || regAddr == vco_band_rb || regAddr == vco_idac_rb
+    || regAddr == wuc_32khzosc_status || regAddr == vco_cal_cfg);
+}
+
+// Position of regAddr in regMap, or -1 if it is not in the map or is volatile
+static int cacheIndex(unsigned int regAddr) {
+  int lo = 0;
+  int hi = ADF7242_MAP_SIZE - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (regMap[mid] == regAddr) {
+      return(volatileReg(regAddr) ? -1 : mid);
+    }
+    if (regMap[mid] < regAddr) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return(-1);
+}
+
+// Sync word written by syncWord(), sync_word0..2. Also the known pattern linkCheck() reads back.
+static const unsigned char syncWordBytes[3] = {0x31, 0x7F, 0xAA};
+
+// Bitmap helpers for the cache valid/dirty flags
+static bool testBit(const unsigned char* map, int i) {
+  return(map[i >> 3] & (1 << (i & 7)));
+}
+static void setBit(unsigned char* map, int i) {
+  map[i >> 3] |= (1 << (i & 7));
+}
+static void clearBit(unsigned char* map, int i) {
+  map[i >> 3] &= ~(1 << (i & 7));
+}
 
 ////////////////////////////////////////////////////////////////////////////
-// ADF7242(int CS)
+// ADF7242(int CS, SPITransport &bus)
 ////////////////////////////////////////////////////////////////////////////
 // Constructor with configurable CS pin and creates _CS private variable
 ////////////////////////////////////////////////////////////////////////////
 // CS - Chip select pin
+// bus - SPI/GPIO transport (TeensySPI on the board)
 ////////////////////////////////////////////////////////////////////////////
-ADF7242::ADF7242(int CS) {
+ADF7242::ADF7242(int CS, SPITransport &bus) : _bus(bus) {
   _CS = CS;
-  pinMode(_CS, OUTPUT); // Set CS pin to be an Output
-  digitalWrite(_CS, HIGH); // Initialize CS pin to be high
+  _bus.pinMode(_CS, OUTPUT); // Set CS pin to be an Output
+  _bus.digitalWrite(_CS, HIGH); // Initialize CS pin to be high
 }
 
 // Destructor
@@ -51,7 +108,7 @@ ADF7242::ADF7242(int CS) {
 ////////////////////////////////////////////////////////////////////////////
 ADF7242::~ADF7242() {
   sleep(); // Put the ADF7242 to sleep
-  SPI.end(); // End SPI communication with ADF7242
+  _bus.end(); // End SPI communication with ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -60,10 +117,12 @@ ADF7242::~ADF7242() {
 // Resets radio controller and puts it to sleep
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::reset() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_RESET); // Resets the ADF7242 and puts it in the sleep state
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
-  delay(3); // Minimum delay as per datasheet is t16 = 2ms
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_RESET); // Resets the ADF7242 and puts it in the sleep state
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  _bus.delay(3); // Minimum delay as per datasheet is t16 = 2ms
+  invalidate(); // Every register is back at its reset value
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -72,10 +131,13 @@ void ADF7242::reset() {
 // Brings radio controller into sleep state
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::sleep() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_SLEEP); // Sleep the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
-  delay(3); // Minimum delay as per datasheet is t16 = 2ms
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_SLEEP); // Sleep the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  _bus.delay(3); // Minimum delay as per datasheet is t16 = 2ms
+  invalidate(); // Configuration is not guaranteed to survive sleep
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -84,10 +146,12 @@ void ADF7242::sleep() {
 // Brings radio controller into idle state
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::idle() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_IDLE); // Sleep the ADF7242
-  delay(1); // allow time for the RC to mellow out
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_IDLE); // Sleep the ADF7242
+  _bus.delay(1); // allow time for the RC to mellow out
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -97,9 +161,11 @@ void ADF7242::idle() {
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::PHY_RDY() {
 	regWrite(vco_cal_cfg, 9); // DO NOT SKIP VCO CAL
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_PHY_RDY); // PHY_RDY the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_PHY_RDY); // PHY_RDY the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -108,9 +174,11 @@ void ADF7242::PHY_RDY() {
 // Performs a clear channel assessment
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::CCA() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_CCA); // CCA the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_CCA); // CCA the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -119,9 +187,11 @@ void ADF7242::CCA() {
 // Brings radio controller into receive state
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::receive() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_RX); // receive the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_RX); // receive the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -130,9 +200,12 @@ void ADF7242::receive() {
 // Brings radio controller into transmit state
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::transmit() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_TX); // transmit the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  PROFILE_SCOPE(transmitProbe);
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_TX); // transmit the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -143,9 +216,11 @@ void ADF7242::transmit() {
 // return - chip temperature from register adc_rbk, field adc_out
 ////////////////////////////////////////////////////////////////////////////
 unsigned char ADF7242::meas() {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(RC_MEAS); // PHY_RDY the ADF7242
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  flush(); // send held register writes first
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(RC_MEAS); // PHY_RDY the ADF7242
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
   #ifdef DEBUG
   	Serial.println(regRead(adc_rbk) & 0x3F, HEX); // print contents of adc_rbk[5..0]
   #endif
@@ -159,64 +234,118 @@ unsigned char ADF7242::meas() {
 // when there are multiple SPI devices using different settings.
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::configSPI() {
-  SPISettings TXSettings(4000000, MSBFIRST, SPI_MODE0);
-  SPI.beginTransaction(TXSettings);
+  _bus.beginTransaction(ADF7242_SPI_CLOCK, MSBFIRST, ADF7242_SPI_MODE);
 }
 
 unsigned char ADF7242::statusRead() {
-  digitalWrite(_CS, LOW);
-  SPI.transfer(SPI_NOP);
-  unsigned char _status = SPI.transfer(SPI_NOP);
-  digitalWrite(_CS, HIGH);
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW);
+  _bus.transfer(ADF7242_SPI_NOP);
+  unsigned char _status = _bus.transfer(ADF7242_SPI_NOP);
+  _bus.digitalWrite(_CS, HIGH);
   return(_status);
 }
 
 ////////////////////////////////////////////////////////////////////////////
 // unsigned char regRead(unsigned int regAddr)
 ////////////////////////////////////////////////////////////////////////////
-// Reads 1 byte of data to the specified register over SPI
+// Reads 1 byte of data to the specified register over SPI. With the cache
+// enabled, configuration registers already known are returned without
+// touching the bus; volatile registers always go to the chip.
 ////////////////////////////////////////////////////////////////////////////
 // regAddr - address of register
 // return - byte of data
 ////////////////////////////////////////////////////////////////////////////
-// TODO - this function can be flaky and doesn't work inside the DEBUG
-//        portion of regWrite
-////////////////////////////////////////////////////////////////////////////
 unsigned char ADF7242::regRead(unsigned int regAddr) {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(SPI_MEMR_RD | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
-  SPI.transfer(0xFF & regAddr); // Address bits [7:0]
-  SPI.transfer(SPI_NOP);
-  unsigned char _dataRead = SPI.transfer(SPI_NOP); // Data byte
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  PROFILE_SCOPE(regReadProbe);
+  int idx = _cacheOn ? cacheIndex(regAddr) : -1;
+  if (idx >= 0 && testBit(_valid, idx)) {
+    ++_cacheHits;
+    return(_shadow[idx]);
+  }
+  unsigned char _dataRead = spiRead(regAddr);
+  if (idx >= 0) {
+    ++_cacheMisses;
+    cacheFill(regAddr, _dataRead);
+  }
   return(_dataRead);
 }
 
 ////////////////////////////////////////////////////////////////////////////
 // void regWrite(unsigned int regAddr, unsigned char regData)
 ////////////////////////////////////////////////////////////////////////////
-// Writes 1 byte of data to the specified register over SPI
+// Writes 1 byte of data to the specified register over SPI. With the cache
+// enabled, writing the value a register already holds is skipped, and in
+// write-back mode the write is held until flush(). A write that goes
+// straight to the chip flushes held writes first, so the chip sees writes
+// in program order.
 ////////////////////////////////////////////////////////////////////////////
 // regAddr - address of register
 // regAddr - byte of data
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::regWrite(unsigned int regAddr, unsigned char regData) {
-  digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-  SPI.transfer(SPI_MEMR_WR | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
-  SPI.transfer(0xFF & regAddr); // Address bits [7:0]
-  SPI.transfer(regData); // Data byte
-  digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  PROFILE_SCOPE(regWriteProbe);
+  if (cacheWrite(regAddr, regData)) {
+    return;
+  }
+  if (_dirtyCount > 0) {
+    flush(); // Held writes were issued first, so they reach the chip first
+  }
+  spiWrite(regAddr, regData);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned char spiRead(unsigned int regAddr)
+////////////////////////////////////////////////////////////////////////////
+// Reads 1 byte of data to the specified register over SPI, bypassing the
+// shadow register cache
+////////////////////////////////////////////////////////////////////////////
+// regAddr - address of register
+// return - byte of data
+////////////////////////////////////////////////////////////////////////////
+// TODO - this function can be flaky and doesn't work inside the DEBUG
+//        portion of regWrite
+////////////////////////////////////////////////////////////////////////////
+unsigned char ADF7242::spiRead(unsigned int regAddr) {
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(SPI_MEMR_RD | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
+  _bus.transfer(0xFF & regAddr); // Address bits [7:0]
+  _bus.transfer(ADF7242_SPI_NOP);
+  unsigned char _dataRead = _bus.transfer(ADF7242_SPI_NOP); // Data byte
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  return(_dataRead);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void spiWrite(unsigned int regAddr, unsigned char regData)
+////////////////////////////////////////////////////////////////////////////
+// Writes 1 byte of data to the specified register over SPI, bypassing the
+// shadow register cache
+////////////////////////////////////////////////////////////////////////////
+// regAddr - address of register
+// regAddr - byte of data
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::spiWrite(unsigned int regAddr, unsigned char regData) {
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(SPI_MEMR_WR | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
+  _bus.transfer(0xFF & regAddr); // Address bits [7:0]
+  _bus.transfer(regData); // Data byte
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
   //digitalWrite(11, LOW); // Software fix for stray capacitance on MOSI line
   //digitalWrite(12, LOW); // Software fix for stray capacitance on MISO line
-  delayMicroseconds(25);
+  _lastCSHigh = _bus.micros(); // Start the write stall time instead of waiting it out here
+  _stallPending = true;
   #ifdef DEBUG
     // Read data just written and verify. Errors will appear in serial terminal
-    digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
-    SPI.transfer(SPI_MEMR_RD | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
-    SPI.transfer(0xFF & regAddr); // Address bits [7:0]
-    SPI.transfer(SPI_NOP);
-    unsigned char _dataRead = SPI.transfer(SPI_NOP); // Data byte
-    digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7
+    waitStall(); // wait out any stall time still owed by the last write
+    _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+    _bus.transfer(SPI_MEMR_RD | ( regAddr >> 8 )); // SPI_MEMR_WR + address bits [10:8]
+    _bus.transfer(0xFF & regAddr); // Address bits [7:0]
+    _bus.transfer(ADF7242_SPI_NOP);
+    unsigned char _dataRead = _bus.transfer(ADF7242_SPI_NOP); // Data byte
+    _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7
     if(_dataRead != regData) {
       Serial.println("!!!!!Reg Write Error!!!!!");
       Serial.print("Register Address: 0x");
@@ -230,11 +359,365 @@ void ADF7242::regWrite(unsigned int regAddr, unsigned char regData) {
   #endif
 }
 
+// Entries from regs[0] that form one run of consecutive addresses within a 256 byte page
+static size_t runLength(const ADF7242RegVal* regs, size_t n, unsigned int gap) {
+  size_t run = 1;
+  while (run < n && regs[run].regAddr > regs[run - 1].regAddr
+    && regs[run].regAddr - regs[run - 1].regAddr <= gap + 1
+    && (regs[run].regAddr >> 8) == (regs[0].regAddr >> 8)) {
+    ++run;
+  }
+  return(run);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void beginWrite(unsigned int regAddr) / void endWrite()
+////////////////////////////////////////////////////////////////////////////
+// Open an SPI_MEM_WR frame at regAddr. Each byte transferred until
+// endWrite() goes to the next address. endWrite() starts the write stall.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::beginWrite(unsigned int regAddr) {
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(SPI_MEM_WR | (regAddr >> 8)); // SPI_MEM_WR + address bits [10:8]
+  _bus.transfer(0xFF & regAddr); // Address bits [7:0]
+}
+
+void ADF7242::endWrite() {
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  _lastCSHigh = _bus.micros(); // Start the write stall time instead of waiting it out here
+  _stallPending = true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int writeRegs(const ADF7242RegVal* regs, size_t n)
+////////////////////////////////////////////////////////////////////////////
+// Writes a register table. Entries with consecutive addresses are merged
+// into one SPI_MEM_WR frame, which auto-increments the address, so a run
+// costs a single command, address, and write stall. With the cache
+// enabled, entries the chip already holds are dropped before merging.
+////////////////////////////////////////////////////////////////////////////
+// regs - register/value pairs in increasing address order
+// n - number of entries
+// return - number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::writeRegs(const ADF7242RegVal* regs, size_t n) {
+  int frames = 0;
+  bool open = false; // An SPI_MEM_WR frame is in progress
+  for (size_t i = 0; i < n; ++i) {
+    bool write = !cacheWrite(regs[i].regAddr, regs[i].data);
+    if (write && _dirtyCount > 0) {
+      // Held writes were issued first, so they reach the chip first
+      if (open) {
+        endWrite();
+        open = false;
+      }
+      frames += flush();
+    }
+    bool extend = write && open && regs[i].regAddr == regs[i - 1].regAddr + 1 && (0xFF & regs[i].regAddr) != 0;
+    if (open && !extend) {
+      endWrite();
+      open = false;
+    }
+    if (write && !open) {
+      beginWrite(regs[i].regAddr);
+      open = true;
+      ++frames;
+    }
+    if (write) {
+      _bus.transfer(regs[i].data); // Data byte, address auto-increments
+    }
+  }
+  if (open) {
+    endWrite();
+  }
+  return(frames);
+}
+
 ////////////////////////////////////////////////////////////////////////////
-// void initFSK(unsigned char dataRate)
+// int verifyRegs(const ADF7242RegVal* regs, size_t n)
+////////////////////////////////////////////////////////////////////////////
+// Reads a register table back with SPI_MEM_RD frames. A frame keeps going
+// across gaps of up to ADF7242_READ_GAP unlisted registers, since
+// clocking a few extra bytes is cheaper than starting a new frame.
+// Volatile registers (RSSI, LQI, IRQ sources, AFC and ADC readback) are
+// skipped. Held write-back registers are flushed first, and every value
+// read refreshes the cache.
+////////////////////////////////////////////////////////////////////////////
+// regs - register/value pairs in increasing address order
+// n - number of entries
+// return - number of registers that did not read back as written
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::verifyRegs(const ADF7242RegVal* regs, size_t n) {
+  flush(); // Held writes must reach the chip before it is compared
+  int mismatches = 0;
+  size_t i = 0;
+  while (i < n) {
+    size_t run = runLength(regs + i, n - i, ADF7242_READ_GAP);
+    unsigned int last = regs[i + run - 1].regAddr;
+    waitStall(); // wait out any stall time still owed by the last write
+    _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+    _bus.transfer(SPI_MEM_RD | (regs[i].regAddr >> 8)); // SPI_MEM_RD + address bits [10:8]
+    _bus.transfer(0xFF & regs[i].regAddr); // Address bits [7:0]
+    _bus.transfer(ADF7242_SPI_NOP);
+    for (unsigned int addr = regs[i].regAddr; addr <= last; ++addr) {
+      unsigned char dataRead = _bus.transfer(ADF7242_SPI_NOP); // Data bytes, address auto-increments
+      if (addr != regs[i].regAddr) {
+        continue; // Gap register, not part of the table
+      }
+      cacheFill(addr, dataRead); // The chip is the truth, matching or not
+      if (!volatileReg(addr) && dataRead != regs[i].data) {
+        ++mismatches;
+        #ifdef DEBUG
+          Serial.print("!!!!!Reg Verify Error!!!!! 0x");
+          Serial.print(addr, HEX);
+          Serial.print(" wrote 0x");
+          Serial.print(regs[i].data, HEX);
+          Serial.print(" read 0x");
+          Serial.println(dataRead, HEX);
+        #endif
+      }
+      ++i;
+    }
+    _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  }
+  return(mismatches);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int loadProfile(const ADF7242RegVal* regs, size_t n)
+////////////////////////////////////////////////////////////////////////////
+// Uploads a radio profile with writeRegs(), then checks it with
+// verifyRegs(). The readback is skipped when the cache shows the chip
+// already held the whole profile.
+////////////////////////////////////////////////////////////////////////////
+// regs - register/value pairs in increasing address order
+// n - number of entries
+// return - number of registers that did not read back as written
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::loadProfile(const ADF7242RegVal* regs, size_t n) {
+  if (writeRegs(regs, n) == 0 && _cacheOn && !_writeBack) {
+    return(0); // Every register already held its value, as last read or verified
+  }
+  return(verifyRegs(regs, n));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void writePacket(const uint8_t* buf, uint8_t len)
+////////////////////////////////////////////////////////////////////////////
+// Writes a complete TX payload to packet RAM in one CS assertion using
+// SPI_PKT_WR, which starts at the txpb base address and auto-increments.
+// The first byte is the PHR length byte (payload + 2 FCS bytes), followed
+// by the payload itself. Bus time grows by one byte per payload byte
+// instead of one SPI_MEMR_WR frame and write stall per byte.
+////////////////////////////////////////////////////////////////////////////
+// buf - payload
+// len - payload length from 1..ADF7242_MAX_PAYLOAD bytes
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::writePacket(const uint8_t* buf, uint8_t len) {
+  PROFILE_SCOPE(writePacketProbe);
+  if (len == 0 || len > ADF7242_MAX_PAYLOAD) {
+    #ifdef DEBUG
+      Serial.println("ERROR: Invalid packet length!");
+    #endif
+    return;
+  }
+  flush(); // txpb/rxpb may be held in the cache
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(SPI_PKT_WR); // Sequential write from txpb
+  _bus.transfer(len + 2); // PHR: payload length plus 2 byte FCS
+  for (uint8_t i = 0; i < len; ++i) {
+    _bus.transfer(buf[i]); // Payload bytes
+  }
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  _lastCSHigh = _bus.micros(); // Start the write stall time instead of waiting it out here
+  _stallPending = true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// uint8_t readPacket(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info)
+////////////////////////////////////////////////////////////////////////////
+// Reads a received packet from packet RAM in one CS assertion using
+// SPI_PKT_RD, which starts at the rxpb base address and auto-increments.
+// The status byte and the PHR length byte come first, then the payload is
+// streamed straight into buf. When the whole payload fits, the two bytes
+// the chip stores in place of the FCS (LQI and RSSI) are read as well.
+////////////////////////////////////////////////////////////////////////////
+// buf - receives the payload
+// maxLen - size of buf. Longer payloads are truncated
+// info - optional, receives status, PHR, LQI, and RSSI
+// return - number of payload bytes copied into buf
+////////////////////////////////////////////////////////////////////////////
+uint8_t ADF7242::readPacket(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info) {
+  PROFILE_SCOPE(readPacketProbe);
+  flush(); // txpb/rxpb may be held in the cache
+  waitStall(); // wait out any stall time still owed by the last write
+  _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+  _bus.transfer(SPI_PKT_RD); // Sequential read from rxpb
+  unsigned char status = _bus.transfer(ADF7242_SPI_NOP); // Status byte
+  unsigned char phr = _bus.transfer(ADF7242_SPI_NOP); // PHR: payload length plus 2
+  uint8_t payloadLen = (phr > 2) ? (phr - 2) : 0;
+  uint8_t copied = (payloadLen < maxLen) ? payloadLen : maxLen;
+  for (uint8_t i = 0; i < copied; ++i) {
+    buf[i] = _bus.transfer(ADF7242_SPI_NOP); // Payload bytes
+  }
+  bool trailer = (copied == payloadLen && phr >= 2);
+  unsigned char lqi = 0;
+  unsigned char rssi = 0;
+  if (trailer && info) {
+    lqi = _bus.transfer(ADF7242_SPI_NOP); // LQI stored in the first FCS byte
+    rssi = _bus.transfer(ADF7242_SPI_NOP); // RSSI stored in the second FCS byte
+  }
+  _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+  if (info) {
+    info->status = status;
+    info->phr = phr;
+    info->lqi = lqi;
+    info->rssi = rssi;
+    info->trailer = trailer;
+  }
+  return(copied);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void cfgIRQ(unsigned char en0, unsigned char en1)
+////////////////////////////////////////////////////////////////////////////
+// Selects which interrupt sources drive the IRQ1 pin and clears any
+// source already latched
+////////////////////////////////////////////////////////////////////////////
+// en0 - irq1_en0 mask, e.g. IRQ_RC_READY
+// en1 - irq1_en1 mask, e.g. IRQ_RX_PKT_RCVD
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::cfgIRQ(unsigned char en0, unsigned char en1) {
+  regWrite(irq1_en0, en0);
+  regWrite(irq1_en1, en1);
+  clearIRQ();
+  #ifdef DEBUG
+    Serial.print("Register irq1_en0: 0x");
+    Serial.println(regRead(irq1_en0), HEX);
+    Serial.print("Register irq1_en1: 0x");
+    Serial.println(regRead(irq1_en1), HEX);
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned char irqSource()
+////////////////////////////////////////////////////////////////////////////
+// return - IRQ1 source bits from irq1_src1 (IRQ_RX_PKT_RCVD etc.)
+////////////////////////////////////////////////////////////////////////////
+unsigned char ADF7242::irqSource() {
+  return(regRead(irq1_src1));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearIRQ()
+////////////////////////////////////////////////////////////////////////////
+// Clears all IRQ1 source bits. Source bits are cleared by writing 1.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::clearIRQ() {
+  regWrite(irq1_src0, 0xFF);
+  regWrite(irq1_src1, 0xFF);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int serviceIRQ(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info)
+////////////////////////////////////////////////////////////////////////////
+// Services an IRQ1 edge in receive mode. Reads and clears irq1_src1. If a
+// packet was received it is read with readPacket() and the receiver is
+// re-armed straight away, before the caller spends any time on the data.
+////////////////////////////////////////////////////////////////////////////
+// buf - receives the payload
+// maxLen - size of buf
+// info - optional, receives status, PHR, LQI, and RSSI
+// return - payload length, or -1 if no packet was received
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::serviceIRQ(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info) {
+  unsigned char src = irqSource();
+  regWrite(irq1_src1, src); // Clear only the bits that were seen
+  if ((src & IRQ_RX_PKT_RCVD) == 0) {
+    return(-1);
+  }
+  uint8_t len = readPacket(buf, maxLen, info);
+  receive(); // Re-arm RX immediately
+  return(len);
+}
+
+// Table 37. Settings common to all GFSK/FSK configurations, in address order
+static constexpr ADF7242RegVal fskCommon[] = {
+  {synt, 0x28},
+  {agc_cfg1, 0x34},
+  {agc_max, 0x80},
+  {agc_cfg2, 0x37},
+  {agc_cfg3, 0x2A},
+  {agc_cfg4, 0x1D},
+  {agc_cfg6, 0x24},
+  {agc_cfg7, 0x7B},
+  {ocl_cfg0, 0x00},
+  {ocl_cfg1, 0x07},
+  {irq1_en0, 0x00},
+  {irq1_en1, 0x08}, // Enables interrupt to be triggered when valid packet is received
+  {irq2_en0, 0x00},
+  {irq2_en1, 0x00},
+  {irq1_src0, 0xFF},
+  {irq1_src1, 0xFF},
+  {ocl_bw0, 0x1A},
+  {ocl_bw1, 0x19},
+  {ocl_bw2, 0x1E},
+  {ocl_bw3, 0x1E},
+  {ocl_bw4, 0x1E},
+  {ocl_bws, 0x00},
+  {ocl_bw13, 0xF0},
+  {preamble_num_validate, 0x03},
+};
+
+// Table 38. Data rate-specific GFSK/FSK settings, in address order. Row n is initFSK(n + 1).
+#define FSK_RATE_REGS 9
+static constexpr ADF7242RegVal fskRate[8][FSK_RATE_REGS] = {
+  // 50kbps FSK
+  {{fsk_preamble, 0x04}, {tx_fd, 0x03}, {dm_cfg0, 0x37}, {tx_m, 0x00}, {dr0, 0x01}, {dr1, 0xF4},
+   {iirf_cfg, 0x17}, {dm_cfg1, 0x08}, {rxfe_cfg, 0x16}},
+  // 62.5kbps FSK
+  {{fsk_preamble, 0x04}, {tx_fd, 0x06}, {dm_cfg0, 0x37}, {tx_m, 0x00}, {dr0, 0x02}, {dr1, 0x71},
+   {iirf_cfg, 0x17}, {dm_cfg1, 0x08}, {rxfe_cfg, 0x16}},
+  // 100kbps FSK
+  {{fsk_preamble, 0x05}, {tx_fd, 0x03}, {dm_cfg0, 0x6B}, {tx_m, 0x00}, {dr0, 0x03}, {dr1, 0xE8},
+   {iirf_cfg, 0x17}, {dm_cfg1, 0x0D}, {rxfe_cfg, 0x16}},
+  // 125kbps FSK
+  {{fsk_preamble, 0x05}, {tx_fd, 0x06}, {dm_cfg0, 0x37}, {tx_m, 0x00}, {dr0, 0x04}, {dr1, 0xE2},
+   {iirf_cfg, 0x17}, {dm_cfg1, 0x11}, {rxfe_cfg, 0x16}},
+  // 250kbps GFSK
+  {{fsk_preamble, 0x05}, {tx_fd, 0x0D}, {dm_cfg0, 0x19}, {tx_m, 0x02}, {dr0, 0x09}, {dr1, 0xC4},
+   {iirf_cfg, 0x12}, {dm_cfg1, 0x20}, {rxfe_cfg, 0x16}},
+  // 500kbps GFSK
+  {{fsk_preamble, 0x05}, {tx_fd, 0x19}, {dm_cfg0, 0x0D}, {tx_m, 0x03}, {dr0, 0x13}, {dr1, 0x88},
+   {iirf_cfg, 0x0A}, {dm_cfg1, 0x3D}, {rxfe_cfg, 0x16}},
+  // 1Mbps GFSK
+  {{fsk_preamble, 0x07}, {tx_fd, 0x19}, {dm_cfg0, 0x0D}, {tx_m, 0x03}, {dr0, 0x27}, {dr1, 0x10},
+   {iirf_cfg, 0x05}, {dm_cfg1, 0x6E}, {rxfe_cfg, 0x16}},
+  // 2Mbps GFSK
+  {{fsk_preamble, 0x09}, {tx_fd, 0x32}, {dm_cfg0, 0x06}, {tx_m, 0x03}, {dr0, 0x4E}, {dr1, 0x20},
+   {iirf_cfg, 0x05}, {dm_cfg1, 0xAA}, {rxfe_cfg, 0x1D}},
+};
+
+// writeRegs() and verifyRegs() rely on tables being in strictly increasing address order
+static constexpr bool ascending(const ADF7242RegVal* regs, size_t n) {
+  return(n < 2 || (regs[0].regAddr < regs[1].regAddr && ascending(regs + 1, n - 1)));
+}
+static constexpr bool ratesAscending(size_t row) {
+  return(row >= 8 || (ascending(fskRate[row], FSK_RATE_REGS) && ratesAscending(row + 1)));
+}
+static_assert(ascending(fskCommon, sizeof(fskCommon) / sizeof(fskCommon[0])), "fskCommon must be in address order");
+static_assert(ratesAscending(0), "fskRate rows must be in address order");
+
+////////////////////////////////////////////////////////////////////////////
+// int initFSK(unsigned char dataRate)
 ////////////////////////////////////////////////////////////////////////////
 // Load settings common to all GFSK/FSK configurations from table 37
 // Load data rate-specific GFSK/FSK settings from table 38
+// Both tables are uploaded with loadProfile(), so the 33 registers take
+// 18 sequential write frames plus 7 readback frames. Calling initFSK()
+// again switches data rate.
 ////////////////////////////////////////////////////////////////////////////
 // dataRate - case 1: 50kbps FSK
 //            case 2: 62.5kbps FSK
@@ -244,156 +727,30 @@ void ADF7242::regWrite(unsigned int regAddr, unsigned char regData) {
 //            case 6: 500kbps GFSK
 //            case 7: 1Mbps GFSK
 //            case 8: 2Mbps GFSK
+// return - number of registers that did not read back as written
 ////////////////////////////////////////////////////////////////////////////
 // TODO - investigate iirf_cfg, agc_cfg5
 ////////////////////////////////////////////////////////////////////////////
-void ADF7242::initFSK(unsigned char dataRate) {
+int ADF7242::initFSK(unsigned char dataRate) {
   #ifdef DEBUG
     Serial.println("Settings common to all GFSK/FSK configurations loaded!");
   #endif
-  // Table 37. Settings common to all GFSK/FSK configurations
-  regWrite(synt,0x28);
-  regWrite(agc_cfg1,0x34); // from table 37
-  regWrite(agc_max,0x80); // from table 37
-  regWrite(agc_cfg2,0x37);
-  regWrite(agc_cfg3,0x2A);
-  regWrite(agc_cfg4,0x1D);
-  regWrite(agc_cfg6,0x24);
-  regWrite(agc_cfg7,0x7B);
-  regWrite(ocl_cfg0,0x00);
-  regWrite(ocl_cfg1,0x07);
-  regWrite(irq1_en0, 0x00);
-  regWrite(irq1_en1, 0x08); // Enables interrupt to be triggered when valid packet is received
-  regWrite(irq2_en0, 0x00);
-  regWrite(irq2_en1, 0x00);
-  regWrite(irq1_src0, 0xFF);
-  regWrite(irq1_src1, 0xFF);
-  regWrite(ocl_bw0,0x1A);
-  regWrite(ocl_bw1,0x19);
-  regWrite(ocl_bw2,0x1E);
-  regWrite(ocl_bw3,0x1E);
-  regWrite(ocl_bw4,0x1E);
-  regWrite(ocl_bws,0x00);
-  regWrite(ocl_bw13,0xF0);
-  regWrite(preamble_num_validate,0x03);
+  int mismatches = loadProfile(fskCommon, sizeof(fskCommon) / sizeof(fskCommon[0]));
+  if (dataRate < 1 || dataRate > 8) {
+    #ifdef DEBUG
+      Serial.println("ERROR: Invalid data rate input!");
+    #endif
+    return(mismatches);
+  }
   #ifdef DEBUG
+    static const char* const rateNames[8] = {"50kbps FSK", "62.5kbps FSK", "100kbps FSK", "125kbps FSK",
+                                             "250kbps GFSK", "500kbps GFSK", "1Mbps GFSK", "2Mbps GFSK"};
     Serial.print("Data rate-specific settings loaded: ");
+    Serial.println(rateNames[dataRate - 1]);
   #endif
-  // Table 38. Data rate-specific GFSK/FSK settings 
-  switch(dataRate) {
-    case 1: // 50kbps FSK
-      #ifdef DEBUG
-        Serial.println("50kbps FSK");
-      #endif
-      regWrite(fsk_preamble,0x04);
-      regWrite(tx_fd,0x03);
-      regWrite(dm_cfg0,0x37);
-      regWrite(tx_m,0x00);
-      regWrite(dr0,0x01);
-      regWrite(dr1,0xF4);
-      regWrite(iirf_cfg,0x17); // from table 38
-      regWrite(dm_cfg1,0x08);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 2: // 62.5kbps FSK
-      #ifdef DEBUG
-        Serial.println("62.5kbps FSK");
-      #endif
-      regWrite(fsk_preamble,0x04);
-      regWrite(tx_fd,0x06);
-      regWrite(dm_cfg0,0x37);
-      regWrite(tx_m,0x00);
-      regWrite(dr0,0x02);
-      regWrite(dr1,0x71);
-      regWrite(iirf_cfg,0x17); // from table 38
-      regWrite(dm_cfg1,0x08);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 3: // 100kbps FSK
-      #ifdef DEBUG
-        Serial.println("100kbps FSK");
-      #endif
-      regWrite(fsk_preamble,0x05);
-      regWrite(tx_fd,0x03);
-      regWrite(dm_cfg0,0x6B);
-      regWrite(tx_m,0x00);
-      regWrite(dr0,0x03);
-      regWrite(dr1,0xE8);
-      regWrite(iirf_cfg,0x17);
-      regWrite(dm_cfg1,0x0D);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 4: // 125kbps FSK
-      #ifdef DEBUG
-        Serial.println("125kbps FSK");
-      #endif
-      regWrite(fsk_preamble,0x05);
-      regWrite(tx_fd,0x06);
-      regWrite(dm_cfg0,0x37);
-      regWrite(tx_m,0x00);
-      regWrite(dr0,0x04);
-      regWrite(dr1,0xE2);
-      regWrite(iirf_cfg,0x17);
-      regWrite(dm_cfg1,0x11);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 5: // 250kbps GFSK
-      #ifdef DEBUG
-        Serial.println("250kbps GFSK");
-      #endif
-      regWrite(fsk_preamble,0x05);
-      regWrite(tx_fd,0x0D);
-      regWrite(dm_cfg0,0x19);
-      regWrite(tx_m,0x02);
-      regWrite(dr0,0x09);
-      regWrite(dr1,0xC4);
-      regWrite(iirf_cfg,0x12);
-      regWrite(dm_cfg1,0x20);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 6: // 500kbps GFSK
-      #ifdef DEBUG
-        Serial.println("500kbps GFSK");
-      #endif
-      regWrite(fsk_preamble,0x05);
-      regWrite(tx_fd,0x19);
-      regWrite(dm_cfg0,0x0D);
-      regWrite(tx_m,0x03);
-      regWrite(dr0,0x13);
-      regWrite(dr1,0x88);
-      regWrite(iirf_cfg,0x0A);
-      regWrite(dm_cfg1,0x3D);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 7: // 1Mbps GFSK
-      #ifdef DEBUG
-        Serial.println("1Mbps GFSK");
-      #endif
-      regWrite(fsk_preamble,0x07);
-      regWrite(tx_fd,0x19);
-      regWrite(dm_cfg0,0x0D);
-      regWrite(tx_m,0x03);
-      regWrite(dr0,0x27);
-      regWrite(dr1,0x10);
-      regWrite(iirf_cfg,0x05);
-      regWrite(dm_cfg1,0x6E);
-      regWrite(rxfe_cfg,0x16);
-      break;
-    case 8: // 2Mbps GFSK
-      #ifdef DEBUG
-        Serial.println("2Mbps GFSK");
-      #endif
-      regWrite(fsk_preamble,0x09);
-      regWrite(tx_fd,0x32);
-      regWrite(dm_cfg0,0x06);
-      regWrite(tx_m,0x03);
-      regWrite(dr0,0x4E);
-      regWrite(dr1,0x20);
-      regWrite(iirf_cfg,0x05);
-      regWrite(dm_cfg1,0xAA);
-      regWrite(rxfe_cfg,0x1D);
-      break;
-  }
+  mismatches += loadProfile(fskRate[dataRate - 1], FSK_RATE_REGS);
+  _preambleBytes = fskRate[dataRate - 1][0].data; // fsk_preamble, kept for airBytes()
+  return(mismatches);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -459,10 +816,14 @@ void ADF7242::setMode(unsigned char mode) {
 // TODO - set length, error tolerance in sync_config
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::syncWord(unsigned long word, unsigned char tol) {
-  regWrite(sync_word0, 0x31); // hardcoded sync word
-  regWrite(sync_word1, 0x7F); // hardcoded sync word
-  regWrite(sync_word2, 0xAA); // hardcoded sync word
-  regWrite(sync_config, 0x10);  // hardcoded sync word tolerance (JC-Was 0x10, but should be 3 words)
+  const ADF7242RegVal regs[] = {
+    {sync_word0, syncWordBytes[0]}, // hardcoded sync word
+    {sync_word1, syncWordBytes[1]}, // hardcoded sync word
+    {sync_word2, syncWordBytes[2]}, // hardcoded sync word
+    {sync_config, 0x10}, // hardcoded sync word tolerance (JC-Was 0x10, but should be 3 words)
+  };
+  writeRegs(regs, 4); // One sequential frame
+  _syncBits = regs[3].data & 0x1F; // Kept for airBytes()
   #ifdef DEBUG
     Serial.print("Sync word length read from sync_config, field sync_len: ");
     Serial.println(regRead(sync_config) & 0x1F);
@@ -488,30 +849,37 @@ void ADF7242::syncWord(unsigned long word, unsigned char tol) {
 // TODO - Fix datasheet p. 99 table 104 bit 6 = 1 on reset
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::cfgPA(unsigned char pwr, bool hp, unsigned char rr) {
-  // PA power level
-  if (pwr <= 15) {
-    regWrite(extpa_msc, (pwr << 4) | 0x01); //regWrite(pa_rr, ); // (2^pa_rr)*2.4ns per PA power step
-  } else {
-    #ifdef DEBUG
-      Serial.println("ERROR: Invalid output power input!");
-    #endif
-  }
+  // Collected in address order so pa_rr and pa_cfg share one sequential frame
+  ADF7242RegVal regs[4];
+  size_t n = 0;
   // PA bias for high power
   if (hp == 1) {
-    regWrite(pa_cfg, 21 | 0x40); // 21 is max for +4.8dBm output power, bit 6 should be 1
-    regWrite(pa_bias, (63 << 1) | 0x01); // 63 is max for +4.8dBm output power
+    regs[n++] = {pa_bias, (63 << 1) | 0x01}; // 63 is max for +4.8dBm output power
   } else {
-    regWrite(pa_cfg, 13 | 0x40); // Default output power on reset, bit 6 should be 1
-    regWrite(pa_bias, (55 << 1) | 0x01); // Default output power on reset
+    regs[n++] = {pa_bias, (55 << 1) | 0x01}; // Default output power on reset
   }
   // PA ramp rate
   if (rr <= 7) {
-    regWrite(pa_rr, rr); // (2^pa_rr)*2.4ns per PA power step
+    regs[n++] = {pa_rr, rr}; // (2^pa_rr)*2.4ns per PA power step
   } else {
     #ifdef DEBUG
       Serial.println("ERROR: Invalid ramp rate input!");
     #endif
   }
+  if (hp == 1) {
+    regs[n++] = {pa_cfg, 21 | 0x40}; // 21 is max for +4.8dBm output power, bit 6 should be 1
+  } else {
+    regs[n++] = {pa_cfg, 13 | 0x40}; // Default output power on reset, bit 6 should be 1
+  }
+  // PA power level
+  if (pwr <= 15) {
+    regs[n++] = {extpa_msc, (unsigned char)((pwr << 4) | 0x01)}; //regWrite(pa_rr, ); // (2^pa_rr)*2.4ns per PA power step
+  } else {
+    #ifdef DEBUG
+      Serial.println("ERROR: Invalid output power input!");
+    #endif
+  }
+  writeRegs(regs, n);
   #ifdef DEBUG
     Serial.print("Register extpa_msc: 0x");
     Serial.println(regRead(extpa_msc), HEX);
@@ -533,9 +901,12 @@ void ADF7242::cfgPA(unsigned char pwr, bool hp, unsigned char rr) {
 //         Should be set to half of the receive baseband filter
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::cfgAFC(unsigned char range) {
-  regWrite(afc_cfg, 0x07); // Sets AFC polarity to 1 and locks AFC on preamble detection
-  regWrite(afc_ki_kp, 0x99); // Sets the AFC PI controller proportional and integral gain
-  regWrite(afc_range, range); // Limits the AFC pull-in range. Should be set to half of the receive baseband filter BW
+  const ADF7242RegVal regs[] = {
+    {afc_cfg, 0x07}, // Sets AFC polarity to 1 and locks AFC on preamble detection
+    {afc_ki_kp, 0x99}, // Sets the AFC PI controller proportional and integral gain
+    {afc_range, range}, // Limits the AFC pull-in range. Should be set to half of the receive baseband filter BW
+  };
+  writeRegs(regs, 3); // One sequential frame
   #ifdef DEBUG
     Serial.print("Register afc_cfg: 0x");
     Serial.println(regRead(afc_cfg), HEX);
@@ -558,8 +929,11 @@ void ADF7242::cfgAFC(unsigned char range) {
 // Rx - receive packet buffer pointer
 ////////////////////////////////////////////////////////////////////////////
 void ADF7242::cfgPB(unsigned char Tx, unsigned char Rx) {
-  regWrite(txpb, Tx); // Sets transmit packet buffer pointer
-  regWrite(rxpb, Rx); // Sets receive packet buffer pointer
+  const ADF7242RegVal regs[] = {
+    {txpb, Tx}, // Sets transmit packet buffer pointer
+    {rxpb, Rx}, // Sets receive packet buffer pointer
+  };
+  writeRegs(regs, 2); // One sequential frame
   #ifdef DEBUG
     Serial.print("Register txpb: 0x");
     Serial.println(regRead(txpb), HEX);
@@ -644,28 +1018,27 @@ void ADF7242::cfgBasicPreamble() {
 ////////////////////////////////////////////////////////////////////////////
 // Dump the ADF7242 register map
 ////////////////////////////////////////////////////////////////////////////
+#if defined(ARDUINO)
 void ADF7242::dumpRegMap() {
-  int regMap [] = {0x100, 0x102, 0x105, 0x106, 0x107, 0x108, 0x109, 0x10A, 0x10B, 0x10C, 0x10D, 0x10E, 0x10F,
-    0x111, 0x13E, 0x300, 0x301, 0x302, 0x304, 0x305, 0x306, 0x30C, 0x30D, 0x30E, 0x30F, 0x313, 0x314, 0x315, 
-    0x316, 0x317, 0x318, 0x319, 0x31A, 0x31B, 0x31E, 0x32C, 0x32D, 0x335, 0x33D, 0x353, 0x354, 0x355, 0x36E, 
-    0x36F, 0x371, 0x380, 0x381, 0x389, 0x38B, 0x395, 0x396, 0x39B, 0x3A7, 0x3A8, 0x3A9, 0x3AA, 0x3AE, 0x3B2, 
-    0x3B4, 0x3B6, 0x3B7, 0x3B8, 0x3B9, 0x3BA, 0x3BC, 0x3BF, 0x3C4, 0x3C7, 0x3C8, 0x3C9, 0x3CA, 0x3CB, 0x3CC, 
-    0x3D2, 0x3D3, 0x3D4, 0x3D5, 0x3D6, 0x3D7, 0x3E0, 0x3E3, 0x3E6, 0x3F0, 0x3F3, 0x3F4, 0x3F7, 0x3F8, 0x3F9, 
-    0x3FA};
-  for (int i = 0; i < 89; ++i)
+  unsigned char values[ADF7242_MAP_SIZE];
+  flush(); // Show what the chip holds, including held writes
+  readMap(values); // A few sequential frames instead of one frame per register
+  for (int i = 0; i < ADF7242_MAP_SIZE; ++i)
   {
     Serial.print("Register 0x");
     Serial.print(regMap[i], HEX);
     Serial.print(" contains value 0x");
-    Serial.println(regRead(regMap[i]), HEX);
+    Serial.println(values[i], HEX);
   }
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////
 // void dumpISB()
 ////////////////////////////////////////////////////////////////////////////
 // Dump the ADF7242 interrupt source bits for status of radio
 ////////////////////////////////////////////////////////////////////////////
+#if defined(ARDUINO)
 void ADF7242::dumpISB() {
   Serial.print("irq1_src0[3] rc_ready: ");
   Serial.println(regRead(irq1_src0) & 0x08, HEX);
@@ -680,6 +1053,262 @@ void ADF7242::dumpISB() {
   Serial.print("irq1_src1[0] cca_complete: ");
   Serial.println(regRead(irq1_src1) & 0x01, HEX);
 }
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// void waitStall()
+////////////////////////////////////////////////////////////////////////////
+// Waits until the write stall time since the last register write has
+// elapsed. Work done since that write (e.g. talking to another chip)
+// counts towards the stall, so only the remainder is burnt here.
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::waitStall() {
+  if (!_stallPending) {
+    return;
+  }
+  // micros() truncates both timestamps, so allow for 1 us of error
+  uint32_t elapsed = _bus.micros() - _lastCSHigh; // 32 bit like micros(), so a wrap cancels out
+  if (elapsed <= (uint32_t)_stall) {
+    uint32_t remaining = _stall - elapsed + 1;
+    _bus.delayMicroseconds(remaining);
+    _stallMicros += remaining;
+  }
+  _stallPending = false;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool cacheWrite(unsigned int regAddr, unsigned char regData)
+////////////////////////////////////////////////////////////////////////////
+// Updates the shadow copy for a register write
+////////////////////////////////////////////////////////////////////////////
+// regAddr - address of register
+// regData - byte being written
+// return - true if the chip write can be skipped: the register already
+//          holds regData, or the write is held for flush()
+////////////////////////////////////////////////////////////////////////////
+bool ADF7242::cacheWrite(unsigned int regAddr, unsigned char regData) {
+  int idx = _cacheOn ? cacheIndex(regAddr) : -1;
+  if (idx < 0) {
+    return(false);
+  }
+  if (testBit(_valid, idx) && _shadow[idx] == regData) {
+    ++_cacheHits;
+    return(true);
+  }
+  ++_cacheMisses;
+  _shadow[idx] = regData;
+  setBit(_valid, idx);
+  if (!_writeBack) {
+    return(false);
+  }
+  if (!testBit(_dirty, idx)) {
+    setBit(_dirty, idx);
+    ++_dirtyCount;
+  }
+  return(true);
+}
+
+// Stores a value read from the chip, unless a held write is pending for it
+void ADF7242::cacheFill(unsigned int regAddr, unsigned char regData) {
+  int idx = _cacheOn ? cacheIndex(regAddr) : -1;
+  if (idx < 0 || testBit(_dirty, idx)) {
+    return;
+  }
+  _shadow[idx] = regData;
+  setBit(_valid, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void cacheEnable(bool enable, bool writeBack)
+////////////////////////////////////////////////////////////////////////////
+// Turns the shadow register cache on or off. The cache starts empty and
+// fills as registers are written or read; sync() loads it in one go.
+////////////////////////////////////////////////////////////////////////////
+// enable - true to cache configuration registers
+// writeBack - true to hold register writes until flush() or the next
+//             radio controller command, false to write through
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::cacheEnable(bool enable, bool writeBack) {
+  flush(); // Nothing stays held across a mode change
+  if (enable && !_cacheOn) {
+    invalidate();
+  }
+  _cacheOn = enable;
+  _writeBack = enable && writeBack;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int flush()
+////////////////////////////////////////////////////////////////////////////
+// Writes every dirty cached register to the chip. Dirty registers at
+// consecutive addresses share one SPI_MEM_WR frame.
+////////////////////////////////////////////////////////////////////////////
+// return - number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::flush() {
+  int frames = 0;
+  bool open = false;
+  for (int i = 0; i < ADF7242_MAP_SIZE && _dirtyCount > 0; ++i) {
+    bool dirty = testBit(_dirty, i);
+    bool extend = dirty && open && regMap[i] == regMap[i - 1] + 1 && (0xFF & regMap[i]) != 0;
+    if (open && !extend) {
+      endWrite();
+      open = false;
+    }
+    if (dirty && !open) {
+      beginWrite(regMap[i]);
+      open = true;
+      ++frames;
+    }
+    if (dirty) {
+      _bus.transfer(_shadow[i]); // Data byte, address auto-increments
+      clearBit(_dirty, i);
+      --_dirtyCount;
+    }
+  }
+  if (open) {
+    endWrite();
+  }
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int readMap(unsigned char* values)
+////////////////////////////////////////////////////////////////////////////
+// Reads every register in the map with SPI_MEM_RD frames, bridging gaps of
+// up to ADF7242_READ_GAP unlisted registers
+////////////////////////////////////////////////////////////////////////////
+// values - receives ADF7242_MAP_SIZE bytes in register map order
+// return - number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::readMap(unsigned char* values) {
+  int frames = 0;
+  int i = 0;
+  while (i < ADF7242_MAP_SIZE) {
+    int last = i;
+    while (last + 1 < ADF7242_MAP_SIZE && regMap[last + 1] - regMap[last] <= ADF7242_READ_GAP + 1
+      && (regMap[last + 1] >> 8) == (regMap[i] >> 8)) {
+      ++last;
+    }
+    waitStall(); // wait out any stall time still owed by the last write
+    _bus.digitalWrite(_CS, LOW); // send CS low to enable SPI transfer to/from ADF7242
+    _bus.transfer(SPI_MEM_RD | (regMap[i] >> 8)); // SPI_MEM_RD + address bits [10:8]
+    _bus.transfer(0xFF & regMap[i]); // Address bits [7:0]
+    _bus.transfer(ADF7242_SPI_NOP);
+    for (unsigned int addr = regMap[i]; addr <= regMap[last]; ++addr) {
+      unsigned char dataRead = _bus.transfer(ADF7242_SPI_NOP); // Data bytes, address auto-increments
+      if (addr == regMap[i]) {
+        values[i++] = dataRead;
+      }
+    }
+    _bus.digitalWrite(_CS, HIGH); // send CS high to disable SPI transfer to/from ADF7242
+    ++frames;
+  }
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int sync()
+////////////////////////////////////////////////////////////////////////////
+// Flushes held writes, then reloads every cacheable register from the
+// chip in a handful of sequential frames
+////////////////////////////////////////////////////////////////////////////
+// return - number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////
+int ADF7242::sync() {
+  int frames = flush();
+  unsigned char values[ADF7242_MAP_SIZE];
+  frames += readMap(values);
+  for (int i = 0; i < ADF7242_MAP_SIZE; ++i) {
+    cacheFill(regMap[i], values[i]);
+  }
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void invalidate()
+////////////////////////////////////////////////////////////////////////////
+// Forgets every cached value, including held writes. Called when the chip
+// loses its configuration (reset, sleep).
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::invalidate() {
+  for (unsigned int i = 0; i < sizeof(_valid); ++i) {
+    _valid[i] = 0;
+    _dirty[i] = 0;
+  }
+  _dirtyCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned long cacheHits() / cacheMisses()
+////////////////////////////////////////////////////////////////////////////
+// Register reads and writes of cacheable registers that were served by
+// the cache, and those that had to go to the chip
+////////////////////////////////////////////////////////////////////////////
+unsigned long ADF7242::cacheHits() {
+  return(_cacheHits);
+}
+
+unsigned long ADF7242::cacheMisses() {
+  return(_cacheMisses);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearCacheStats()
+////////////////////////////////////////////////////////////////////////////
+// Resets the cache hit/miss counters
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::clearCacheStats() {
+  _cacheHits = 0;
+  _cacheMisses = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned int airBytes(unsigned char len)
+////////////////////////////////////////////////////////////////////////////
+// Bytes the transmitter puts on air for one GFSK/FSK packet: preamble,
+// sync word, PHR, payload, and the 2 byte FCS. Used to report payload
+// efficiency. Valid after initFSK() and syncWord().
+////////////////////////////////////////////////////////////////////////////
+// len - payload length in bytes
+// return - total bytes on air
+////////////////////////////////////////////////////////////////////////////
+unsigned int ADF7242::airBytes(unsigned char len) {
+  return(_preambleBytes + (_syncBits + 7) / 8 + 1 + len + 2);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool linkCheck()
+////////////////////////////////////////////////////////////////////////////
+// Reads sync_word0..2 straight from the chip, bypassing the cache, and
+// compares them to the sync word syncWord() writes. Used as the known
+// pattern when probing the fastest usable SPI clock (see SPIBus::probe()).
+// Only meaningful after syncWord().
+////////////////////////////////////////////////////////////////////////////
+// return - true if all three bytes read back as written
+////////////////////////////////////////////////////////////////////////////
+bool ADF7242::linkCheck() {
+  return(spiRead(sync_word0) == syncWordBytes[0] && spiRead(sync_word1) == syncWordBytes[1]
+    && spiRead(sync_word2) == syncWordBytes[2]);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned long stallMicros()
+////////////////////////////////////////////////////////////////////////////
+// Returns the total time in microseconds spent waiting for stall time
+////////////////////////////////////////////////////////////////////////////
+unsigned long ADF7242::stallMicros() {
+  return(_stallMicros);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearStallMicros()
+////////////////////////////////////////////////////////////////////////////
+// Clears the stall time counter
+////////////////////////////////////////////////////////////////////////////
+void ADF7242::clearStallMicros() {
+  _stallMicros = 0;
+}
 
 //////////////////////////////////////////////////////////////////////////////
 // closeSPI()
@@ -687,7 +1316,7 @@ void ADF7242::dumpISB() {
 // Ends the current SPI transaction, allowing different settings to be loaded
 //////////////////////////////////////////////////////////////////////////////
 void ADF7242::closeSPI(){
-  SPI.endTransaction();
+  _bus.endTransaction();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -696,5 +1325,5 @@ void ADF7242::closeSPI(){
 // A dummy write which does not trigger CS. Used when the SPI mode is changed
 //////////////////////////////////////////////////////////////////////////////
 void ADF7242::dummySPIWrite(){
-  SPI.transfer(SPI_NOP);
+  _bus.transfer(ADF7242_SPI_NOP);
 }
\ No newline at end of file
@@ -27,13 +27,17 @@
 #ifndef ADF7242_h
 #define ADF7242_h
 
-#include "Arduino.h"
-#include <SPI.h>
+#include <SPITransport.h>
 
 //#define DEBUG // uncomment for DEBUG mode
 
+// SPI settings loaded by configSPI(), also used to register the chip with SPIBus
+#define ADF7242_SPI_CLOCK 4000000 // Commands and register configuration
+#define ADF7242_SPI_DATA_CLOCK 8000000 // Packet RAM transfers (SPIBUS_DATA profile)
+#define ADF7242_SPI_MODE SPI_MODE0
+
 // SPI Command List for ADF7242
-#define SPI_NOP 0xFF // No operation. Use for dummy writes.
+#define ADF7242_SPI_NOP 0xFF // No operation. Use for dummy writes.
 #define SPI_PKT_WR 0x10 // Write data to the packet RAM starting from the transmit packet base address pointer, Register txpb, Field tx_pkt_base (0x314[7:0]).
 #define SPI_PKT_RD 0x30 // Read data from the packet RAM starting from the receive packet base address pointer, Register rxpb, Field rx_pkt_base (0x315[7:0]).
 #define SPI_MEM_WR 0x18 // 0x18 + memory address[10:8] // Write data to MCR or packet RAM sequentially. 
@@ -51,6 +55,24 @@
 #define RC_PC_RESET 0xC7 // Program counter reset. This should only be used after a firmware download to the program RAM.
 #define RC_RESET 0xC8 // Resets the ADF7242 and puts it in the sleep state.
 
+// irq1_src0 / irq1_en0 bits
+#define IRQ_RC_READY 0x08 // Radio controller ready for a command
+// irq1_src1 / irq1_en1 bits
+#define IRQ_TX_PKT_SENT 0x10 // Packet transmission complete
+#define IRQ_RX_PKT_RCVD 0x08 // Packet received
+#define IRQ_TX_SFD 0x04 // Sync word / SFD transmitted
+#define IRQ_RX_SFD 0x02 // Sync word / SFD detected
+#define IRQ_CCA_COMPLETE 0x01 // Clear channel assessment complete
+
+// Largest payload that fits a packet (PHR max of 127 less the 2 byte FCS)
+#define ADF7242_MAX_PAYLOAD 125
+
+// Unlisted registers a verifyRegs() readback frame clocks through instead of starting a new frame
+#define ADF7242_READ_GAP 8
+
+// Registers in the Table 50 register map below, the size of the shadow register cache
+#define ADF7242_MAP_SIZE 89
+
 // Register Map from Table 50
 #define ext_ctrl 0x100 // External LNA/PA and internal PA control configuration bits
 #define fsk_preamble 0x102 // GFSK/FSK preamble length configuration
@@ -142,10 +164,29 @@
 #define afc_range 0x3F9 // AFC range
 #define afc_read 0x3FA // AFC frequency error readback
 
+// One register/value pair of a radio profile table
+struct ADF7242RegVal {
+	unsigned int regAddr;
+	unsigned char data;
+};
+
+// Receive metadata returned by ADF7242::readPacket()
+struct ADF7242RxInfo {
+	unsigned char status; // Status byte clocked out with SPI_PKT_RD
+	unsigned char phr; // Length byte (payload + 2)
+	unsigned char lqi; // Link quality stored after the payload
+	unsigned char rssi; // RSSI stored after the LQI
+	bool trailer; // True when lqi and rssi were read
+};
+
 class ADF7242 {
 public:
 	// Constructor with chip select (CS) pin
-	ADF7242(int CS);
+#if defined(ARDUINO)
+	ADF7242(int CS, SPITransport &bus = TeensySPI);
+#else
+	ADF7242(int CS, SPITransport &bus);
+#endif
 
 	// Destructor
 	~ADF7242();
@@ -186,8 +227,35 @@ public:
 	// Write register
 	void regWrite(unsigned int regAddr, unsigned char regData);
 
+	// Write a register table, merging consecutive addresses into sequential frames
+	int writeRegs(const ADF7242RegVal* regs, size_t n);
+
+	// Read a register table back with sequential frames and count mismatches
+	int verifyRegs(const ADF7242RegVal* regs, size_t n);
+
+	// Write and verify a radio profile table
+	int loadProfile(const ADF7242RegVal* regs, size_t n);
+
+	// Write PHR and payload to packet RAM in one sequential transaction
+	void writePacket(const uint8_t* buf, uint8_t len);
+
+	// Read PHR, payload, and trailing LQI/RSSI in one sequential transaction
+	uint8_t readPacket(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info = 0);
+
+	// Route interrupt sources to the IRQ1 pin
+	void cfgIRQ(unsigned char en0, unsigned char en1);
+
+	// Read the IRQ1 source bits (irq1_src1)
+	unsigned char irqSource();
+
+	// Clear all IRQ1 source bits
+	void clearIRQ();
+
+	// Service an IRQ1 edge: read and clear the source, fetch the packet, re-arm RX
+	int serviceIRQ(uint8_t* buf, uint8_t maxLen, ADF7242RxInfo* info = 0);
+
 	// Initialize FSK at data rate
-	void initFSK(unsigned char dataRate);
+	int initFSK(unsigned char dataRate);
 
 	// TRx frequency in MHz
 	void chFreq(long freq);
@@ -216,22 +284,102 @@ public:
 	// Configure a basic preamble which allows 0 errors
 	void cfgBasicPreamble();
 
+	// Enable or disable the shadow register cache. writeBack holds register writes until flush()
+	void cacheEnable(bool enable, bool writeBack = false);
+
+	// Write every dirty cached register to the chip
+	int flush();
+
+	// Flush, then reload the cache from the chip
+	int sync();
+
+	// Forget every cached value
+	void invalidate();
+
+	// Register accesses served by the cache, and accesses that had to go to the chip
+	unsigned long cacheHits();
+	unsigned long cacheMisses();
+
+	// Reset the cache hit/miss counters
+	void clearCacheStats();
+
+	// Bytes on air for a packet carrying len payload bytes
+	unsigned int airBytes(unsigned char len);
+
+	// Read the sync word registers past the cache and compare them to what syncWord() wrote
+	bool linkCheck();
+
+	// Microseconds spent waiting for stall time since the last clear
+	unsigned long stallMicros();
+
+	// Reset the stall time counter
+	void clearStallMicros();
+
 	// Close SPI Transaction
 	void closeSPI();
 
+#if defined(ARDUINO)
 	// Dump the entire register map from the memory for debugging
 	void dumpRegMap();
 
 	// Dump the ADF7242 interrupt source bits for status of radio
 	void dumpISB();
+#endif
 
 	//Dummy write with no CS call to force the MCU into a different SPI mode
 	void dummySPIWrite();
 
 private:
+	// SPI/GPIO transport
+	SPITransport &_bus;
+
 	// Chip select pin
 	int _CS;
 
+	// Waits for the rest of the write stall time, if any
+	void waitStall();
+
+	// Single register SPI frames, bypassing the cache
+	unsigned char spiRead(unsigned int regAddr);
+	void spiWrite(unsigned int regAddr, unsigned char regData);
+
+	// Open and close an SPI_MEM_WR sequential write frame
+	void beginWrite(unsigned int regAddr);
+	void endWrite();
+
+	// Read the whole register map with sequential frames. Returns the number of frames.
+	int readMap(unsigned char* values);
+
+	// Cache bookkeeping for a register write. True when the chip write can be skipped.
+	bool cacheWrite(unsigned int regAddr, unsigned char regData);
+
+	// Store a value read from the chip in the cache
+	void cacheFill(unsigned int regAddr, unsigned char regData);
+
+	// Write stall time in microseconds
+	unsigned long _stall = 25;
+
+	// Time of the last register write CS rising edge, and whether its stall is still owed
+	uint32_t _lastCSHigh = 0;
+	bool _stallPending = false;
+
+	// Total microseconds spent waiting for stall time
+	unsigned long _stallMicros = 0;
+
+	// Shadow register cache, indexed like the register map. _valid and _dirty are bitmaps.
+	bool _cacheOn = false;
+	bool _writeBack = false;
+	unsigned char _shadow[ADF7242_MAP_SIZE];
+	unsigned char _valid[(ADF7242_MAP_SIZE + 7) / 8] = {0};
+	unsigned char _dirty[(ADF7242_MAP_SIZE + 7) / 8] = {0};
+	int _dirtyCount = 0;
+	unsigned long _cacheHits = 0;
+	unsigned long _cacheMisses = 0;
+
+	// Preamble length in bytes and sync word length in bits, read back by initFSK() and syncWord()
+	unsigned char _preambleBytes = 0;
+	unsigned char _syncBits = 0;
+
 };
 
 #endif
\ No newline at end of file
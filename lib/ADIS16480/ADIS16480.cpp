@@ -24,25 +24,69 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ADIS16480.h"
+#include <Profiler.h>
+
+// Hot path probes, compiled out unless PROFILE is defined in Profiler.h
+PROFILE_PROBE(regReadProbe, "ADIS16480::regRead");
+PROFILE_PROBE(regWriteProbe, "ADIS16480::regWrite");
+PROFILE_PROBE(readSampleProbe, "ADIS16480::readSample");
+
+// Shadowed configuration registers, in address order and in the order of the
+// ADIS16480Config fields. Pages 2 and 3 only, so refresh() switches page once.
+static const uint16_t configRegs[ADIS16480_CONFIG_REGS] = {
+  X_GYRO_SCALE, Y_GYRO_SCALE, Z_GYRO_SCALE, X_ACCL_SCALE, Y_ACCL_SCALE, Z_ACCL_SCALE,
+  XG_BIAS_LOW, XG_BIAS_HIGH, YG_BIAS_LOW, YG_BIAS_HIGH, ZG_BIAS_LOW, ZG_BIAS_HIGH,
+  XA_BIAS_LOW, XA_BIAS_HIGH, YA_BIAS_LOW, YA_BIAS_HIGH, ZA_BIAS_LOW, ZA_BIAS_HIGH,
+  HARD_IRON_X, HARD_IRON_Y, HARD_IRON_Z,
+  SOFT_IRON_S11, SOFT_IRON_S12, SOFT_IRON_S13, SOFT_IRON_S21, SOFT_IRON_S22, SOFT_IRON_S23,
+  SOFT_IRON_S31, SOFT_IRON_S32, SOFT_IRON_S33, BR_BIAS_LOW, BR_BIAS_HIGH,
+  REFMTX_R11, REFMTX_R12, REFMTX_R13, REFMTX_R21, REFMTX_R22, REFMTX_R23,
+  REFMTX_R31, REFMTX_R32, REFMTX_R33, USER_SCR_1, USER_SCR_2, USER_SCR_3, USER_SCR_4,
+  FNCTIO_CTRL, CONFIG, DEC_RATE, FILTR_BNK_0, FILTR_BNK_1, ALM_CNFG_0, ALM_CNFG_1, ALM_CNFG_2,
+  XG_ALM_MAGN, YG_ALM_MAGN, ZG_ALM_MAGN, XA_ALM_MAGN, YA_ALM_MAGN, ZA_ALM_MAGN,
+  XM_ALM_MAGN, YM_ALM_MAGN, ZM_ALM_MAGN, BR_ALM_MAGN,
+  EKF_CNFG, DECLN_ANGL, ACC_DISTB_THR, MAG_DISTB_THR,
+  QCVR_NOIS_LWR, QCVR_NOIS_UPR, QCVR_RRW_LWR, QCVR_RRW_UPR,
+  RCVR_ACC_LWR, RCVR_ACC_UPR, RCVR_MAG_LWR, RCVR_MAG_UPR
+};
+
+// Position of regAddr in configRegs, or -1 if it is not shadowed
+static int shadowIndex(uint16_t regAddr) {
+  int lo = 0;
+  int hi = ADIS16480_CONFIG_REGS - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (configRegs[mid] == regAddr) {
+      return(mid);
+    }
+    if (configRegs[mid] < regAddr) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return(-1);
+}
 
 ////////////////////////////////////////////////////////////////////////////
-// ADIS16480(int CS)
+// ADIS16480(int CS, int DR, int RST, SPITransport &bus)
 ////////////////////////////////////////////////////////////////////////////
 // Constructor with configurable CS pin and creates _CS private variable
 ////////////////////////////////////////////////////////////////////////////
 // CS - Chip select pin
 // DR - DR output pin for data ready
 // RST - Hardware reset pin
+// bus - SPI/GPIO transport (TeensySPI on the board)
 ////////////////////////////////////////////////////////////////////////////
-ADIS16480::ADIS16480(int CS, int DR, int RST) {
+ADIS16480::ADIS16480(int CS, int DR, int RST, SPITransport &bus) : _bus(bus) {
   _CS = CS;
   _DR = DR;
   _RST = RST;
-  pinMode(_CS, OUTPUT); // Set CS pin to be an output
-  pinMode(_DR, INPUT); // Set DR pin to be an input
-  pinMode(_RST, OUTPUT); // Set RST pin to be an output
-  digitalWrite(_CS, HIGH); // Initialize CS pin to be high
-  digitalWrite(_RST, HIGH); // Initialize RST pin to be high
+  _bus.pinMode(_CS, OUTPUT); // Set CS pin to be an output
+  _bus.pinMode(_DR, INPUT); // Set DR pin to be an input
+  _bus.pinMode(_RST, OUTPUT); // Set RST pin to be an output
+  _bus.digitalWrite(_CS, HIGH); // Initialize CS pin to be high
+  _bus.digitalWrite(_RST, HIGH); // Initialize RST pin to be high
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -52,7 +96,7 @@ ADIS16480::~ADIS16480() {
   // Put device to sleep
   //sleep();
   // Close SPI bus
-  SPI.end();
+  _bus.end();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -61,10 +105,13 @@ ADIS16480::~ADIS16480() {
 // Performs hardware reset by sending _RST pin low for 2 seconds
 ////////////////////////////////////////////////////////////////////////////
 int ADIS16480::reset(uint16_t ms) {
-  digitalWrite(_RST, LOW);
-  delayMicroseconds(500);
-  digitalWrite(_RST, HIGH);
-  delay(ms);
+  _bus.digitalWrite(_RST, LOW);
+  _bus.delayMicroseconds(500);
+  _bus.digitalWrite(_RST, HIGH);
+  _bus.delay(ms);
+  currentPage = 0x00; // The sensor comes out of reset on page 0
+  invalidate(); // Unsaved configuration is lost
+  _acqValid = false; // SEQ_CNT restarts
   return(1);
 }
 
@@ -75,7 +122,7 @@ int ADIS16480::reset(uint16_t ms) {
 ////////////////////////////////////////////////////////////////////////////
 int ADIS16480::tare() {
   regWrite(GLOB_CMD, 0x100);
-  delay(10); 
+  _bus.delay(10); 
   return (1);
 }
 
@@ -86,18 +133,28 @@ int ADIS16480::tare() {
 // when there are multiple SPI devices using different settings.
 ////////////////////////////////////////////////////////////////////////////
 int ADIS16480::configSPI() {
-  SPISettings IMUSettings(1000000, MSBFIRST, SPI_MODE3);
-  SPI.beginTransaction(IMUSettings);
+  _bus.beginTransaction(ADIS16480_SPI_CLOCK, MSBFIRST, ADIS16480_SPI_MODE);
   return(1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
-// Reads two bytes (one word) in two sequential registers over SPI
+// Reads two bytes (one word) in two sequential registers over SPI. Shadowed
+// configuration registers already known are returned without any SPI frames.
 ////////////////////////////////////////////////////////////////////////////////////////////
 // regAddr - address of register to be read
 // return - (int) signed 16 bit 2's complement number
 ////////////////////////////////////////////////////////////////////////////////////////////
 uint16_t ADIS16480::regRead(uint16_t regAddr) {
+  PROFILE_SCOPE(regReadProbe);
+  int idx = shadowIndex(regAddr);
+  if (idx >= 0) {
+    if (_valid[idx >> 3] & (1 << (idx & 7))) {
+      ++_cacheHits;
+      return(_shadow[idx]);
+    }
+    ++_cacheMisses;
+  }
+
   // Separate page ID from register address
   uint8_t page = ((regAddr >> 8) & 0xFF);
   uint8_t address = (regAddr & 0xFF);
@@ -105,36 +162,365 @@ uint16_t ADIS16480::regRead(uint16_t regAddr) {
   // Check whether the sensor is currently on the requested page
   if (currentPage != page) {
     // Write desired page to PAGE_ID register
-    digitalWrite(_CS, LOW); // Set CS low to enable device
-    SPI.transfer(0x80); // Write high byte from low word to SPI bus
-    SPI.transfer(page); // Write low byte from low word to SPI bus
-    digitalWrite(_CS, HIGH); // Set CS high to disable device
+    spiFrame(0x8000 | page);
     // Write new current page to tracking variable
     currentPage = page; 
-    delayMicroseconds(_stall); // Stall time delay
   }
 
-  // Write desired register address
-  digitalWrite(_CS, LOW); // Set CS low to enable device
-  SPI.transfer(address); // Write address over SPI bus
-  SPI.transfer(0x00); // Write 0x00 to the SPI bus fill the 16 bit transaction requirement
-  digitalWrite(_CS, HIGH); // Set CS high to disable device
-
-  delayMicroseconds(_stall); // Stall time delay
+  // Write desired register address. 0x00 fills the 16 bit transaction requirement
+  spiFrame(address << 8);
 
   // Read data from requested register
-  digitalWrite(_CS, LOW); // Set CS low to enable device
-  uint16_t _dataOut = (SPI.transfer(0x00) << 8) | (SPI.transfer(0x00) & 0xFF); // Concatenate upper and lower bytes
-  digitalWrite(_CS, HIGH); // Set CS high to disable device
+  uint16_t _dataOut = spiFrame(0x0000);
+  shadowStore(regAddr, _dataOut);
 
-  delayMicroseconds(_stall); // Stall time delay
+  return(_dataOut);
+}
 
-  //uint16_t _dataOut = (_msbData << 8) | (_lsbData); // Concatenate upper and lower bytes
-  // Shift MSB data left by 8 bits, mask LSB data with 0xFF, and OR both bits.
 
-  return(_dataOut);
+////////////////////////////////////////////////////////////////////////////////////////////
+// Reads a list of registers using the sensor's pipelined SPI protocol
+////////////////////////////////////////////////////////////////////////////////////////////
+// Every frame sends the next read request while clocking out the result of
+// the previous one, so n registers on the same page take n+1 frames instead
+// of 2n. A page change costs one extra frame; the PAGE_ID write still clocks
+// out the pending result, so nothing is lost across pages.
+////////////////////////////////////////////////////////////////////////////////////////////
+// addrs - list of register addresses ({PAGE_ID, Address} format) to be read
+// out - buffer receiving n register values in the same order as addrs
+// n - number of registers to read
+// return - (int) number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////////////////////
+int ADIS16480::regReadBurst(const uint16_t* addrs, uint16_t* out, size_t n) {
+  _pipeFrames = 0;
+  for (size_t i = 0; i < n; ++i) {
+    pipeSelectPage((addrs[i] >> 8) & 0xFF); // Switch pages if needed
+    pipeRead(addrs[i] & 0xFF, &out[i]); // Request this register and collect the previous one
+  }
+  pipeFlush(); // One trailing frame clocks out the last requested register
+  return(_pipeFrames);
+}
+
+// Output registers read by readSample(), in address order. Indices below refer to this table.
+static const uint16_t sampleRegs[ADIS16480_SAMPLE_REGS] = {
+  SEQ_CNT, SYS_E_FLAG, TEMP_OUT, // 0..2
+  X_GYRO_LOW, X_GYRO_OUT, Y_GYRO_LOW, Y_GYRO_OUT, Z_GYRO_LOW, Z_GYRO_OUT, // 3..8
+  X_ACCL_LOW, X_ACCL_OUT, Y_ACCL_LOW, Y_ACCL_OUT, Z_ACCL_LOW, Z_ACCL_OUT, // 9..14
+  X_MAGN_OUT, Y_MAGN_OUT, Z_MAGN_OUT, BAROM_LOW, BAROM_OUT, // 15..19
+  X_DELTANG_LOW, X_DELTANG_OUT, Y_DELTANG_LOW, Y_DELTANG_OUT, Z_DELTANG_LOW, Z_DELTANG_OUT, // 20..25
+  X_DELTVEL_LOW, X_DELTVEL_OUT, Y_DELTVEL_LOW, Y_DELTVEL_OUT, Z_DELTVEL_LOW, Z_DELTVEL_OUT, // 26..31
+  ROLL_C23_OUT, PITCH_C31_OUT, YAW_C32_OUT // 32..34
+};
+
+// Combines an _OUT (upper) and _LOW (lower) register pair
+static inline int32_t combine(uint16_t upper, uint16_t lower) {
+  return((int32_t)(((uint32_t)upper << 16) | lower));
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////
+// Reads every output register into a full resolution sample
+////////////////////////////////////////////////////////////////////////////////////////////
+// All registers live on page 0, so the whole sample costs one pipelined burst
+// of ADIS16480_SAMPLE_REGS + 1 frames (plus a PAGE_ID write if the sensor was
+// left on another page). Call right after data ready so the burst does not
+// straddle an output register update.
+////////////////////////////////////////////////////////////////////////////////////////////
+// sample - receives the combined 32 bit and 16 bit fields, stamped with micros()
+// return - (int) number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////////////////////
+int ADIS16480::readSample(ADIS16480Sample &sample) {
+  PROFILE_SCOPE(readSampleProbe);
+  uint16_t raw[ADIS16480_SAMPLE_REGS];
+  int frames = regReadBurst(sampleRegs, raw, ADIS16480_SAMPLE_REGS);
+
+  sample.timestamp = _bus.micros();
+  sample.seqCnt = raw[0];
+  sample.sysEFlag = raw[1];
+  sample.temp = (int16_t)raw[2];
+  for (int i = 0; i < 3; ++i) {
+    sample.gyro[i] = combine(raw[4 + 2 * i], raw[3 + 2 * i]);
+    sample.accl[i] = combine(raw[10 + 2 * i], raw[9 + 2 * i]);
+    sample.magn[i] = (int16_t)raw[15 + i];
+    sample.deltAng[i] = combine(raw[21 + 2 * i], raw[20 + 2 * i]);
+    sample.deltVel[i] = combine(raw[27 + 2 * i], raw[26 + 2 * i]);
+    sample.euler[i] = (int16_t)raw[32 + i];
+  }
+  sample.barom = combine(raw[19], raw[18]);
+
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Reads a sample taken at a known data ready edge and tracks the acquisition
+////////////////////////////////////////////////////////////////////////////////////////////
+// Compares SEQ_CNT with the previous sample to count samples the caller
+// never read, and the timestamps of consecutive samples to measure the data
+// ready period and its jitter. Intervals spanning a gap are left out of the
+// jitter figures; the gap itself is counted in skipped. Call from the data
+// ready handler with micros() taken on entry.
+////////////////////////////////////////////////////////////////////////////////////////////
+// sample - receives the combined 32 bit and 16 bit fields
+// timestamp - micros() at the data ready edge
+// return - (int) number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////////////////////
+int ADIS16480::readSample(ADIS16480Sample &sample, uint32_t timestamp) {
+  int frames = readSample(sample);
+  sample.timestamp = timestamp;
+
+  ++_acq.samples;
+  if (_acqValid) {
+    uint16_t gap = (uint16_t)(sample.seqCnt - _lastSeqCnt - 1);
+    if (gap >= 0x8000) {
+      ++_acq.restarts; // A backwards jump means the sensor was reset
+    } else if (gap > 0) {
+      _acq.skipped += gap;
+    } else {
+      uint32_t interval = timestamp - _lastTimestamp;
+      ++_acq.intervals;
+      _acq.intervalSum += interval;
+      if (interval < _acq.minInterval) {
+        _acq.minInterval = interval;
+      }
+      if (interval > _acq.maxInterval) {
+        _acq.maxInterval = interval;
+      }
+    }
+  }
+  _lastSeqCnt = sample.seqCnt;
+  _lastTimestamp = timestamp;
+  _acqValid = true;
+
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// const ADIS16480AcqStats &acqStats()
+////////////////////////////////////////////////////////////////////////////
+// Counters kept by readSample(sample, timestamp). The mean data ready
+// period is intervalSum / intervals, the peak-to-peak jitter maxInterval -
+// minInterval. With no sample skipped the pipeline keeps up at the current
+// DEC_RATE.
+////////////////////////////////////////////////////////////////////////////
+const ADIS16480AcqStats &ADIS16480::acqStats() {
+  return(_acq);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearAcqStats()
+////////////////////////////////////////////////////////////////////////////
+// Resets the acquisition counters. The next sample is still compared with
+// the last one read.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::clearAcqStats() {
+  ADIS16480AcqStats cleared = {0, 0, 0, 0, 0, 0xFFFFFFFF, 0};
+  _acq = cleared;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Executes a batch of register reads and writes grouped by page
+////////////////////////////////////////////////////////////////////////////////////////////
+// Operations are regrouped so that every page is visited once, starting with
+// the page the sensor is already on and then in order of first appearance.
+// Operations on the same page keep their relative order. All frames are
+// pipelined: a read result is collected by whichever frame follows it, be it
+// the next read, a write, or a PAGE_ID switch.
+//
+// Reordering across pages is only safe when no operation depends on another
+// one on a different page. Do not put PAGE_ID itself in a batch.
+////////////////////////////////////////////////////////////////////////////////////////////
+// ops - operations to execute. Read results are returned in ops[i].data
+// n - number of operations
+// stats - optional, receives frames and page switches issued and saved
+//         compared to executing the operations one regRead/regWrite at a time
+// return - (int) number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////////////////////
+int ADIS16480::regBatch(ADIS16480RegOp* ops, size_t n, ADIS16480BatchStats* stats) {
+  // Cost of issuing the operations one at a time, in the order given
+  int naiveFrames = 0;
+  int naiveSwitches = 0;
+  uint8_t page = currentPage;
+  for (size_t i = 0; i < n; ++i) {
+    uint8_t opPage = (ops[i].regAddr >> 8) & 0xFF;
+    if (opPage != page) {
+      ++naiveSwitches;
+      page = opPage;
+    }
+    naiveFrames += 2; // Address + data for a read, low + high byte for a write
+  }
+  naiveFrames += naiveSwitches;
+
+  // Visit the current page first, then every other page once
+  uint8_t visited[32] = {0}; // One bit per page
+  int switches = 0;
+  _pipeFrames = 0;
+  for (size_t i = 0; i <= n; ++i) {
+    uint8_t groupPage;
+    size_t first;
+    if (i == 0) {
+      groupPage = currentPage;
+      first = 0;
+    } else {
+      groupPage = (ops[i - 1].regAddr >> 8) & 0xFF;
+      first = i - 1;
+    }
+    if (visited[groupPage >> 3] & (1 << (groupPage & 0x07))) {
+      continue;
+    }
+    visited[groupPage >> 3] |= (1 << (groupPage & 0x07));
+
+    for (size_t j = first; j < n; ++j) {
+      if (((ops[j].regAddr >> 8) & 0xFF) != groupPage) {
+        continue;
+      }
+      if (pipeSelectPage(groupPage)) {
+        ++switches;
+      }
+      uint8_t address = ops[j].regAddr & 0xFF;
+      if (ops[j].write) {
+        pipeWrite(address, ops[j].data);
+      } else {
+        pipeRead(address, &ops[j].data);
+      }
+    }
+  }
+  pipeFlush();
+
+  // Keep the shadow in step with what was read and written
+  for (size_t i = 0; i < n; ++i) {
+    shadowStore(ops[i].regAddr, ops[i].data);
+  }
+
+  if (stats) {
+    stats->frames = _pipeFrames;
+    stats->pageSwitches = switches;
+    stats->framesSaved = naiveFrames - _pipeFrames;
+    stats->pageSwitchesSaved = naiveSwitches - switches;
+  }
+  return(_pipeFrames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Pipeline helpers used by regReadBurst() and regBatch(). Every frame
+// clocks out the answer to the frame before it; _pipeDest remembers where
+// that answer belongs.
+////////////////////////////////////////////////////////////////////////////
+// Sends one frame, stores the pending read result, and queues dest (or
+// nothing, for writes) as the next result to collect.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::pipeFrame(uint16_t txWord, uint16_t* dest) {
+  uint16_t rxWord = spiFrame(txWord);
+  if (_pipeDest) {
+    *_pipeDest = rxWord;
+  }
+  _pipeDest = dest;
+  ++_pipeFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Switches to page if the sensor is not already on it. Returns true if a
+// PAGE_ID write was issued.
+////////////////////////////////////////////////////////////////////////////
+bool ADIS16480::pipeSelectPage(uint8_t page) {
+  if (currentPage == page) {
+    return(false);
+  }
+  pipeFrame(0x8000 | page, 0);
+  currentPage = page;
+  return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Requests a register on the current page; its value lands in *dest when
+// the next frame is sent.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::pipeRead(uint8_t address, uint16_t* dest) {
+  pipeFrame((address & 0x7F) << 8, dest);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Writes a register on the current page (two frames, low byte first)
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::pipeWrite(uint8_t address, uint16_t regData) {
+  uint16_t addr = (((address & 0x7F) | 0x80) << 8);
+  pipeFrame(addr | (regData & 0xFF), 0);
+  pipeFrame((addr | 0x100) | ((regData >> 8) & 0xFF), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Sends a trailing frame if a read result is still inside the sensor
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::pipeFlush() {
+  if (_pipeDest) {
+    pipeFrame(0x0000, 0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Transfers a single 16 bit word in its own CS frame. Returns the word
+// clocked out by the sensor during the frame.
+////////////////////////////////////////////////////////////////////////////
+// txWord - word to be written to the SPI bus
+////////////////////////////////////////////////////////////////////////////
+uint16_t ADIS16480::spiFrame(uint16_t txWord) {
+  waitStall(); // Wait out whatever is left of the previous stall time
+  _bus.digitalWrite(_CS, LOW); // Set CS low to enable device
+  uint16_t rxWord = (_bus.transfer(txWord >> 8) << 8); // Exchange high byte
+  rxWord |= (_bus.transfer(txWord & 0xFF) & 0xFF); // Exchange low byte
+  _bus.digitalWrite(_CS, HIGH); // Set CS high to disable device
+  _lastCSHigh = _bus.micros(); // Stall time starts now
+  _stallPending = true;
+  return(rxWord);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Waits until the stall time since the last CS rising edge has elapsed.
+// Time spent on other work (e.g. talking to another chip) since the last
+// frame counts towards the stall, so only the remainder is burnt here.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::waitStall() {
+  if (!_stallPending) {
+    return;
+  }
+  // micros() truncates both timestamps, so allow for 1 us of error
+  uint32_t elapsed = _bus.micros() - _lastCSHigh;
+  if (elapsed <= (uint32_t)_stall) {
+    uint32_t remaining = _stall - elapsed + 1;
+    _bus.delayMicroseconds(remaining);
+    _stallMicros += remaining;
+  }
+  _stallPending = false;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool linkCheck()
+////////////////////////////////////////////////////////////////////////////
+// Reads PROD_ID and compares it to ADIS16480_PROD_ID. Used as the known
+// pattern when probing the fastest usable SPI clock (see SPIBus::probe()).
+// Read only: page 0 must already be selected, at the configuration clock,
+// since a PAGE_ID write at a trial clock could be garbled.
+////////////////////////////////////////////////////////////////////////////
+// return - true if PROD_ID read back correctly, false if not on page 0
+////////////////////////////////////////////////////////////////////////////
+bool ADIS16480::linkCheck() {
+  if (currentPage != 0x00) {
+    return(false); // Never select the page here
+  }
+  return(regRead(PROD_ID) == ADIS16480_PROD_ID);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Returns the total time in microseconds spent waiting for stall time
+////////////////////////////////////////////////////////////////////////////
+uint32_t ADIS16480::stallMicros() {
+  return(_stallMicros);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Clears the stall time counter
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::clearStallMicros() {
+  _stallMicros = 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////
 // Writes one byte of data to the specified register over SPI.
@@ -144,6 +530,7 @@ uint16_t ADIS16480::regRead(uint16_t regAddr) {
 // regData - data to be written to the register
 ////////////////////////////////////////////////////////////////////////////
 int ADIS16480::regWrite(uint16_t regAddr, int16_t regData) {
+  PROFILE_SCOPE(regWriteProbe);
   // Separate page ID from register address
   uint8_t page = ((regAddr >> 8) & 0xFF);
   uint8_t address = (regAddr & 0xFF);
@@ -151,13 +538,9 @@ int ADIS16480::regWrite(uint16_t regAddr, int16_t regData) {
   // Check whether the sensor is currently on the requested page
   if (currentPage != page) {
     // Write desired page to PAGE_ID register
-    digitalWrite(_CS, LOW); // Set CS low to enable device
-    SPI.transfer(0x80); // Write high byte from low word to SPI bus
-    SPI.transfer(page); // Write low byte from low word to SPI bus
-    digitalWrite(_CS, HIGH); // Set CS high to disable device
+    spiFrame(0x8000 | page);
     // Write new current page to tracking variable
     currentPage = page; 
-    delayMicroseconds(_stall); // Stall time delay
   }
 
   // Sanity-check address and register data
@@ -165,23 +548,98 @@ int ADIS16480::regWrite(uint16_t regAddr, int16_t regData) {
   uint16_t lowWord = (addr | (regData & 0xFF)); // OR Register address (A) with data(D) (AADD)
   uint16_t highWord = ((addr | 0x100) | ((regData >> 8) & 0xFF)); // OR Register address with data and increment address
 
+  // Write lowWord to SPI bus
+  spiFrame(lowWord);
+
   // Write highWord to SPI bus
-  digitalWrite(_CS, LOW); // Set CS low to enable device
-  SPI.transfer(lowWord >> 8); // Write high byte from low word to SPI bus
-  SPI.transfer(lowWord & 0xFF); // Write low byte from low word to SPI bus
-  digitalWrite(_CS, HIGH); // Set CS high to disable device
+  spiFrame(highWord);
+  shadowStore(regAddr, regData);
 
-  delayMicroseconds(_stall); // Stall time delay
+  return(1);
+}
 
-  // Write lowWord to SPI bus
-  digitalWrite(_CS, LOW); // Set CS low to enable device
-  SPI.transfer(highWord >> 8); // Write high byte from high word to SPI bus
-  SPI.transfer(highWord & 0xFF); // Write low byte from high word to SPI bus
-  digitalWrite(_CS, HIGH); // Set CS high to disable device
+////////////////////////////////////////////////////////////////////////////
+// Records regData as the current value of regAddr if it is shadowed. A
+// GLOB_CMD write (bias null, factory restore, software reset, ...) may change
+// any configuration register, so it empties the shadow instead.
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::shadowStore(uint16_t regAddr, uint16_t regData) {
+  if (regAddr == GLOB_CMD) {
+    if (regData & 0x80) {
+      currentPage = 0x00; // Software reset returns the sensor to page 0
+    }
+    invalidate();
+    return;
+  }
+  int idx = shadowIndex(regAddr);
+  if (idx >= 0) {
+    _shadow[idx] = regData;
+    _valid[idx >> 3] |= (1 << (idx & 7));
+  }
+}
 
-  delayMicroseconds(_stall); // Stall time delay
+////////////////////////////////////////////////////////////////////////////
+// const ADIS16480Config &config()
+////////////////////////////////////////////////////////////////////////////
+// Returns the shadowed configuration registers without any SPI traffic.
+// Fields that were never read or written since the last invalidate() are
+// stale; refresh() loads all of them.
+////////////////////////////////////////////////////////////////////////////
+const ADIS16480Config &ADIS16480::config() {
+  return(_config);
+}
 
-  return(1);
+////////////////////////////////////////////////////////////////////////////////////////////
+// Re-reads every shadowed configuration register from the sensor
+////////////////////////////////////////////////////////////////////////////////////////////
+// configRegs is in address order, so the sweep is one pipelined burst with a
+// single PAGE_ID write between pages 2 and 3: at most ADIS16480_CONFIG_REGS + 3
+// frames, against two or three frames per register for regRead().
+////////////////////////////////////////////////////////////////////////////////////////////
+// return - (int) number of SPI frames issued
+////////////////////////////////////////////////////////////////////////////////////////////
+int ADIS16480::refresh() {
+  int frames = regReadBurst(configRegs, _shadow, ADIS16480_CONFIG_REGS);
+  for (unsigned int i = 0; i < sizeof(_valid); ++i) {
+    _valid[i] = 0xFF;
+  }
+  return(frames);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void invalidate()
+////////////////////////////////////////////////////////////////////////////
+// Forgets every shadowed value. Called when the sensor may have changed its
+// configuration on its own (reset, GLOB_CMD).
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::invalidate() {
+  for (unsigned int i = 0; i < sizeof(_valid); ++i) {
+    _valid[i] = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// unsigned long cacheHits() / cacheMisses()
+////////////////////////////////////////////////////////////////////////////
+// Reads of shadowed registers that were served by the shadow, and those
+// that had to go to the sensor
+////////////////////////////////////////////////////////////////////////////
+unsigned long ADIS16480::cacheHits() {
+  return(_cacheHits);
+}
+
+unsigned long ADIS16480::cacheMisses() {
+  return(_cacheMisses);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearCacheStats()
+////////////////////////////////////////////////////////////////////////////
+// Resets the shadow hit/miss counters
+////////////////////////////////////////////////////////////////////////////
+void ADIS16480::clearCacheStats() {
+  _cacheHits = 0;
+  _cacheMisses = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -190,7 +648,7 @@ int ADIS16480::regWrite(uint16_t regAddr, int16_t regData) {
 // Ends the current SPI transaction, allowing different settings to be loaded
 //////////////////////////////////////////////////////////////////////////////
 int ADIS16480::closeSPI(){
-  SPI.endTransaction();
+  _bus.endTransaction();
   return(1);
 }
 
@@ -200,5 +658,5 @@ int ADIS16480::closeSPI(){
 // A dummy write which does not trigger CS. Used when the SPI mode is changed
 //////////////////////////////////////////////////////////////////////////////
 void ADIS16480::dummySPIWrite(){
-  SPI.transfer(0x00); // Write dummy data to force SPI phase/polarity change
+  _bus.transfer(0x00); // Write dummy data to force SPI phase/polarity change
 }
\ No newline at end of file
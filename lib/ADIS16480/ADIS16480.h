@@ -24,12 +24,18 @@
 
 #ifndef ADIS16480_h
 #define ADIS16480_h
-#include "Arduino.h"
-#include <SPI.h>
+#include <SPITransport.h>
 
 //#define DEBUG // uncomment for DEBUG mode
 
-#define SPI_NOP 0x00 // No operation. Use for dummy writes.
+// SPI settings loaded by configSPI(), also used to register the sensor with SPIBus
+#define ADIS16480_SPI_CLOCK 1000000 // Configuration and flash writes
+#define ADIS16480_SPI_DATA_CLOCK 8000000 // Output register reads (SPIBUS_DATA profile)
+#define ADIS16480_SPI_MODE SPI_MODE3
+
+#define ADIS16480_PROD_ID 0x4060 // PROD_ID contents (16,480), the known pattern read by linkCheck()
+
+#define ADIS16480_SPI_NOP 0x00 // No operation. Use for dummy writes.
 
 // User Register Memory Map from Table 9
 #define PAGE_ID 0x0000 // 0x00, R/W, No, Page identifier, N/A
@@ -174,12 +180,109 @@
 #define FIR_COEF_D_LOW 0x0B02 // to 0x7E N/A, R/W, Yes, FIR Filter Bank D Coefficients 0 through 59, Table 74
 #define FIR_COEF_D_HIGH 0x0C02 // to 0x7E N/A, R/W, Yes, FIR Filter Bank D Coefficients 60 through 119, Table 74
 
+// Full resolution sample assembled by ADIS16480::readSample(). 32 bit fields
+// combine the _OUT (upper) and _LOW (lower) registers.
+struct __attribute__((packed)) ADIS16480Sample {
+  uint32_t timestamp; // micros() at the data ready edge
+  uint16_t seqCnt; // SEQ_CNT
+  uint16_t sysEFlag; // SYS_E_FLAG
+  int16_t temp; // TEMP_OUT
+  int32_t gyro[3]; // X/Y/Z_GYRO_OUT:X/Y/Z_GYRO_LOW
+  int32_t accl[3]; // X/Y/Z_ACCL_OUT:X/Y/Z_ACCL_LOW
+  int16_t magn[3]; // X/Y/Z_MAGN_OUT
+  int32_t barom; // BAROM_OUT:BAROM_LOW
+  int32_t deltAng[3]; // X/Y/Z_DELTANG_OUT:X/Y/Z_DELTANG_LOW
+  int32_t deltVel[3]; // X/Y/Z_DELTVEL_OUT:X/Y/Z_DELTVEL_LOW
+  int16_t euler[3]; // ROLL_C23_OUT, PITCH_C31_OUT, YAW_C32_OUT
+};
+
+// Scale factors for ADIS16480Sample fields, in engineering units per LSB
+constexpr float ADIS16480_GYRO_SCALE = 0.02f / 65536.0f; // deg/sec (0.02 deg/sec per _OUT LSB)
+constexpr float ADIS16480_ACCL_SCALE = 0.8f / 65536.0f; // mg (0.8 mg per _OUT LSB)
+constexpr float ADIS16480_MAGN_SCALE = 0.1f; // mgauss
+constexpr float ADIS16480_BAROM_SCALE = 40.0f / 65536.0f; // ubar (40 ubar per _OUT LSB)
+constexpr float ADIS16480_TEMP_SCALE = 0.00565f; // degC, 0 LSB = 25 degC
+constexpr float ADIS16480_TEMP_OFFSET = 25.0f; // degC
+constexpr float ADIS16480_DELTANG_SCALE = 720.0f / 2147483648.0f; // deg (+/-720 deg full scale)
+constexpr float ADIS16480_DELTVEL_SCALE = 200.0f / 2147483648.0f; // m/sec (+/-200 m/sec full scale)
+constexpr float ADIS16480_EULER_SCALE = 180.0f / 32768.0f; // deg
+
+// Number of registers read by ADIS16480::readSample()
+#define ADIS16480_SAMPLE_REGS 35
+
+// Internal sample rate [SPS]. Data ready runs at ADIS16480_BASE_RATE / (DEC_RATE + 1).
+#define ADIS16480_BASE_RATE 2460
+
+// Acquisition counters kept by ADIS16480::readSample(), cleared by clearAcqStats()
+struct ADIS16480AcqStats {
+  unsigned long samples; // Samples read
+  unsigned long skipped; // SEQ_CNT values missing between consecutive samples
+  unsigned long restarts; // SEQ_CNT jumped backwards (sensor reset)
+  unsigned long intervals; // Data ready intervals measured, between samples with no SEQ_CNT gap
+  uint64_t intervalSum; // Sum of the measured intervals [us]
+  uint32_t minInterval; // Shortest data ready interval [us]
+  uint32_t maxInterval; // Longest data ready interval [us]
+};
+
+// Number of configuration registers shadowed by ADIS16480 (see ADIS16480Config)
+#define ADIS16480_CONFIG_REGS 75
+
+// Typed view of the R/W configuration registers on pages 2 and 3, one field
+// per register in address order. 32 bit fields combine a _LOW/_LWR register
+// with the _HIGH/_UPR register right after it. GPIO_CTRL and SLP_CNT are left
+// out: they do not read back what was written.
+struct __attribute__((packed)) ADIS16480Config {
+  int16_t gyroScale[3]; // X/Y/Z_GYRO_SCALE
+  int16_t acclScale[3]; // X/Y/Z_ACCL_SCALE
+  int32_t gyroBias[3]; // XG/YG/ZG_BIAS_HIGH:XG/YG/ZG_BIAS_LOW
+  int32_t acclBias[3]; // XA/YA/ZA_BIAS_HIGH:XA/YA/ZA_BIAS_LOW
+  int16_t hardIron[3]; // HARD_IRON_X/Y/Z
+  int16_t softIron[9]; // SOFT_IRON_S11..S33
+  int32_t baromBias; // BR_BIAS_HIGH:BR_BIAS_LOW
+  int16_t refMtx[9]; // REFMTX_R11..R33
+  uint16_t userScr[4]; // USER_SCR_1..4
+  uint16_t fnctioCtrl; // FNCTIO_CTRL
+  uint16_t config; // CONFIG
+  uint16_t decRate; // DEC_RATE
+  uint16_t filtrBnk[2]; // FILTR_BNK_0/1
+  uint16_t almCnfg[3]; // ALM_CNFG_0..2
+  int16_t almMagn[10]; // XG..BR_ALM_MAGN
+  uint16_t ekfCnfg; // EKF_CNFG
+  int16_t declnAngl; // DECLN_ANGL
+  uint16_t accDistbThr; // ACC_DISTB_THR
+  uint16_t magDistbThr; // MAG_DISTB_THR
+  float qcvrNois; // QCVR_NOIS_UPR:QCVR_NOIS_LWR, IEEE 754
+  float qcvrRrw; // QCVR_RRW_UPR:QCVR_RRW_LWR, IEEE 754
+  float rcvrAcc; // RCVR_ACC_UPR:RCVR_ACC_LWR, IEEE 754
+  float rcvrMag; // RCVR_MAG_UPR:RCVR_MAG_LWR, IEEE 754
+};
+static_assert(sizeof(ADIS16480Config) == 2 * ADIS16480_CONFIG_REGS, "ADIS16480Config must hold one word per register");
+
+// One register operation for ADIS16480::regBatch()
+struct ADIS16480RegOp {
+  uint16_t regAddr; // {PAGE_ID, Address}
+  uint16_t data; // Data to write, or data read back
+  bool write; // true = write, false = read
+};
+
+// Frame accounting returned by ADIS16480::regBatch()
+struct ADIS16480BatchStats {
+  int frames; // SPI frames issued
+  int pageSwitches; // PAGE_ID writes issued
+  int framesSaved; // Frames saved compared to one regRead/regWrite per operation
+  int pageSwitchesSaved; // PAGE_ID writes saved compared to the order given
+};
+
 // ADIS16480 class definition
 class ADIS16480{
 
 public:
   // Constructor with configurable CS, data ready, and HW reset pins
-  ADIS16480(int CS, int DR, int RST);
+#if defined(ARDUINO)
+  ADIS16480(int CS, int DR, int RST, SPITransport &bus = TeensySPI);
+#else
+  ADIS16480(int CS, int DR, int RST, SPITransport &bus);
+#endif
   // Destructor
   ~ADIS16480();
 
@@ -192,12 +295,55 @@ public:
   // Sets SPI bit order, clock divider, and data mode
   int configSPI();
 
-  // Write data to sensor
+  // Write data to sensor. Shadowed configuration registers are updated too.
   int regWrite(uint16_t regAddr, int16_t regData);
 
-  // Read single register from sensor
+  // Read single register from sensor, or from the shadow for known configuration registers
   uint16_t regRead(uint16_t regAddr);
 
+  // Typed view of the configuration register shadow. Call refresh() first.
+  const ADIS16480Config &config();
+
+  // Re-read every shadowed configuration register in one pipelined sweep
+  int refresh();
+
+  // Forget every shadowed value
+  void invalidate();
+
+  // Shadowed register reads served without SPI, and those that had to go to the sensor
+  unsigned long cacheHits();
+  unsigned long cacheMisses();
+
+  // Reset the shadow hit/miss counters
+  void clearCacheStats();
+
+  // Read a list of registers using pipelined SPI frames
+  int regReadBurst(const uint16_t* addrs, uint16_t* out, size_t n);
+
+  // Read every output register into a full resolution sample in one burst
+  int readSample(ADIS16480Sample &sample);
+
+  // Same, stamping the sample with the data ready edge time and updating the acquisition counters
+  int readSample(ADIS16480Sample &sample, uint32_t timestamp);
+
+  // SEQ_CNT gaps and data ready jitter since the last clear
+  const ADIS16480AcqStats &acqStats();
+
+  // Reset the acquisition counters
+  void clearAcqStats();
+
+  // Execute reads and writes grouped by page using pipelined SPI frames
+  int regBatch(ADIS16480RegOp* ops, size_t n, ADIS16480BatchStats* stats = 0);
+
+  // Read PROD_ID from the device and compare it to ADIS16480_PROD_ID. Page 0 must already be selected.
+  bool linkCheck();
+
+  // Microseconds spent waiting for stall time since the last clear
+  uint32_t stallMicros();
+
+  // Reset the stall time counter
+  void clearStallMicros();
+
   // Close SPI Transaction
   int closeSPI();
 
@@ -205,6 +351,31 @@ public:
   void dummySPIWrite();
 
 private:
+  // Transfers one 16 bit CS-framed word and returns the word clocked out
+  uint16_t spiFrame(uint16_t txWord);
+
+  // Waits for the rest of the stall time since the last frame, if any
+  void waitStall();
+
+  // Pipelined frame helpers for regReadBurst() and regBatch()
+  void pipeFrame(uint16_t txWord, uint16_t* dest);
+  bool pipeSelectPage(uint8_t page);
+  void pipeRead(uint8_t address, uint16_t* dest);
+  void pipeWrite(uint8_t address, uint16_t regData);
+  void pipeFlush();
+
+  // Store a value read from or written to the sensor in the shadow
+  void shadowStore(uint16_t regAddr, uint16_t regData);
+
+  // Destination of the read result the next frame will clock out
+  uint16_t* _pipeDest = 0;
+
+  // Frames issued by the current pipelined operation
+  int _pipeFrames = 0;
+
+  // SPI/GPIO transport
+  SPITransport &_bus;
+
   // Chip select pin
   int _CS;
 
@@ -217,9 +388,33 @@ private:
   // SPI stall time
   int _stall = 10;
 
+  // Time of the last CS rising edge, and whether its stall is still owed
+  uint32_t _lastCSHigh = 0;
+  bool _stallPending = false;
+
+  // Total microseconds spent waiting for stall time
+  uint32_t _stallMicros = 0;
+
   // Current page
   int currentPage = 0x00;
 
+  // Configuration register shadow, in the order of ADIS16480Config. _valid is a bitmap.
+  union {
+    ADIS16480Config _config;
+    uint16_t _shadow[ADIS16480_CONFIG_REGS];
+  };
+  uint8_t _valid[(ADIS16480_CONFIG_REGS + 7) / 8] = {0};
+
+  // Shadow statistics
+  unsigned long _cacheHits = 0;
+  unsigned long _cacheMisses = 0;
+
+  // Acquisition counters, and the SEQ_CNT and timestamp of the previous sample
+  ADIS16480AcqStats _acq = {0, 0, 0, 0, 0, 0xFFFFFFFF, 0};
+  uint16_t _lastSeqCnt = 0;
+  uint32_t _lastTimestamp = 0;
+  bool _acqValid = false;
+
 };
 
 #endif
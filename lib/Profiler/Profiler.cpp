@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Profiler.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+
+#ifdef PROFILE
+
+// Head of the probe list. Zero before any constructor runs, so probes may register in any order.
+static ProfileProbe* probes = 0;
+
+#if defined(ARDUINO)
+// Masks interrupts and returns the previous PRIMASK, so a caller that already
+// runs masked (an ISR, another critical section) stays masked on restore
+static inline uint32_t maskInterrupts() {
+  uint32_t primask;
+  __asm__ volatile("mrs %0, primask" : "=r" (primask) :: "memory");
+  __asm__ volatile("cpsid i" ::: "memory");
+  return(primask);
+}
+
+static inline void restoreInterrupts(uint32_t primask) {
+  __asm__ volatile("msr primask, %0" :: "r" (primask) : "memory");
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// ProfileProbe(const char* name)
+////////////////////////////////////////////////////////////////////////////
+// name - shown in the dump, only the first PROFILE_NAME characters are kept
+////////////////////////////////////////////////////////////////////////////
+ProfileProbe::ProfileProbe(const char* name) : _name(name), _next(probes) {
+  probes = this;
+  reset();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void snapshot(ProfileRecord &rec)
+////////////////////////////////////////////////////////////////////////////
+// Copies the counters. On the Teensy interrupts are held off for the copy
+// so a probe fed by an ISR is never caught half updated. The interrupt mask
+// is restored, not cleared, so this is safe from an ISR.
+////////////////////////////////////////////////////////////////////////////
+// rec - receives the counters and the probe name
+////////////////////////////////////////////////////////////////////////////
+void ProfileProbe::snapshot(ProfileRecord &rec) const {
+  rec.ticksPerSecond = profileTicksPerSecond();
+  size_t i = 0;
+  for (; i < PROFILE_NAME && _name[i]; ++i) {
+    rec.name[i] = _name[i];
+  }
+  for (; i < PROFILE_NAME; ++i) {
+    rec.name[i] = 0;
+  }
+#if defined(ARDUINO)
+  uint32_t primask = maskInterrupts();
+#endif
+  rec.count = _count;
+  rec.min = _count ? _min : 0;
+  rec.max = _max;
+  rec.total = _total;
+  for (int b = 0; b < PROFILE_BUCKETS; ++b) {
+    rec.buckets[b] = _buckets[b];
+  }
+#if defined(ARDUINO)
+  restoreInterrupts(primask);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clear()
+////////////////////////////////////////////////////////////////////////////
+// Forgets every measurement. Interrupts are held off like in snapshot(),
+// so an ISR ending a ProfileScope cannot mix old and new counters.
+////////////////////////////////////////////////////////////////////////////
+void ProfileProbe::clear() {
+#if defined(ARDUINO)
+  uint32_t primask = maskInterrupts();
+#endif
+  reset();
+#if defined(ARDUINO)
+  restoreInterrupts(primask);
+#endif
+}
+
+void ProfileProbe::reset() {
+  _count = 0;
+  _min = 0xFFFFFFFF;
+  _max = 0;
+  _total = 0;
+  for (int b = 0; b < PROFILE_BUCKETS; ++b) {
+    _buckets[b] = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void profileBegin()
+////////////////////////////////////////////////////////////////////////////
+// Enables the DWT cycle counter, which is off after reset. Call once from
+// setup() before anything is measured. Nothing to do on the host.
+////////////////////////////////////////////////////////////////////////////
+void profileBegin() {
+#if defined(ARDUINO)
+  ARM_DEMCR |= ARM_DEMCR_TRCENA;
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+uint32_t profileTicksPerSecond() {
+#if defined(ARDUINO)
+  return(F_CPU);
+#else
+  return(1000000000UL);
+#endif
+}
+
+ProfileProbe* profileFirst() {
+  return(probes);
+}
+
+int profileCount() {
+  int n = 0;
+  for (ProfileProbe* p = probes; p; p = p->next()) {
+    ++n;
+  }
+  return(n);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool profileSnapshot(int index, ProfileRecord &rec)
+////////////////////////////////////////////////////////////////////////////
+// index - probe number, 0..profileCount()-1
+// rec - receives the probe's counters
+// return - false if there is no such probe
+////////////////////////////////////////////////////////////////////////////
+bool profileSnapshot(int index, ProfileRecord &rec) {
+  ProfileProbe* p = probes;
+  for (int i = 0; p && i < index; ++i) {
+    p = p->next();
+  }
+  if (!p) {
+    return(false);
+  }
+  p->snapshot(rec);
+  return(true);
+}
+
+void profileClear() {
+  for (ProfileProbe* p = probes; p; p = p->next()) {
+    p->clear();
+  }
+}
+
+#endif
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Profiler.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Hot path profiler. A probe is a named set of counters (count, min, max, total, and a histogram
+//  with one bucket per power of two) fed by PROFILE_SCOPE() at the top of the code it measures. Time
+//  is read from the Cortex-M4 DWT cycle counter on the Teensy and from std::chrono::steady_clock
+//  (in ns) on the host.
+//
+//  Probes only exist while PROFILE is defined below. Without it the PROFILE_* macros expand to
+//  nothing and Profiler.cpp is empty, so production builds carry no code or data for them.
+//  ProfileRecord, the snapshot format sent over USB serial as a TELEM_PROFILE frame, is always
+//  defined so the host tools can decode it.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef Profiler_h
+#define Profiler_h
+
+//#define PROFILE // uncomment to compile in the hot path probes
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PROFILE_BUCKETS 24 // Bucket i counts durations of 2^i..2^(i+1)-1 ticks, the last one anything longer
+#define PROFILE_NAME 24 // Characters of the probe name kept in a ProfileRecord
+
+// Snapshot of one probe, as dumped by profileSnapshot(). Durations are in ticks.
+struct __attribute__((packed)) ProfileRecord {
+  uint32_t ticksPerSecond; // F_CPU on the Teensy, 1e9 on the host
+  uint32_t count; // Measurements taken
+  uint32_t min; // Shortest duration
+  uint32_t max; // Longest duration
+  uint64_t total; // Sum of all durations, mean = total / count
+  uint32_t buckets[PROFILE_BUCKETS]; // log2 histogram
+  char name[PROFILE_NAME]; // Probe name, NUL padded, not always terminated
+};
+
+#ifdef PROFILE
+
+#if defined(ARDUINO)
+#include "Arduino.h"
+#else
+#include <chrono>
+#endif
+
+// Current time in ticks, wrapping at 32 bits
+static inline uint32_t profileTicks() {
+#if defined(ARDUINO)
+  return(ARM_DWT_CYCCNT);
+#else
+  return((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// ProfileProbe class definition. Probes are defined at file scope and link themselves into a list
+// at start up, so profileSnapshot() can walk every probe in the program.
+class ProfileProbe {
+
+public:
+  ProfileProbe(const char* name);
+
+  // Add one measurement
+  void record(uint32_t ticks) {
+    ++_count;
+    _total += ticks;
+    if (ticks < _min) {
+      _min = ticks;
+    }
+    if (ticks > _max) {
+      _max = ticks;
+    }
+    int bucket = ticks ? 31 - __builtin_clz(ticks) : 0; // One CLZ instruction on the Cortex-M4
+    ++_buckets[bucket < PROFILE_BUCKETS ? bucket : PROFILE_BUCKETS - 1];
+  }
+
+  // Copy the counters into a dump record
+  void snapshot(ProfileRecord &rec) const;
+
+  // Forget every measurement
+  void clear();
+
+  // Next probe in the list, 0 after the last
+  ProfileProbe* next() const {
+    return(_next);
+  }
+
+private:
+  // Zero the counters, without masking interrupts
+  void reset();
+
+  const char* _name;
+  ProfileProbe* _next;
+  uint32_t _count;
+  uint32_t _min;
+  uint32_t _max;
+  uint64_t _total;
+  uint32_t _buckets[PROFILE_BUCKETS];
+};
+
+// Measures the lifetime of the enclosing block into a probe
+class ProfileScope {
+
+public:
+  ProfileScope(ProfileProbe &probe) : _probe(probe), _start(profileTicks()) {}
+
+  ~ProfileScope() {
+    _probe.record(profileTicks() - _start);
+  }
+
+private:
+  ProfileProbe &_probe;
+  uint32_t _start;
+};
+
+// Start the time base (enables the DWT cycle counter on the Teensy)
+void profileBegin();
+
+// Ticks per second of profileTicks()
+uint32_t profileTicksPerSecond();
+
+// First probe of the list, 0 if there is none
+ProfileProbe* profileFirst();
+
+// Number of probes in the program
+int profileCount();
+
+// Snapshot of the index-th probe. Returns false past the last probe.
+bool profileSnapshot(int index, ProfileRecord &rec);
+
+// Forget the measurements of every probe
+void profileClear();
+
+#define PROFILE_PROBE(var, name) static ProfileProbe var(name) // Define a probe at file scope
+#define PROFILE_SCOPE(var) ProfileScope var##Scope(var) // Time the rest of the enclosing block
+#define PROFILE_BEGIN() profileBegin()
+
+#else
+
+#define PROFILE_PROBE(var, name)
+#define PROFILE_SCOPE(var)
+#define PROFILE_BEGIN()
+
+#endif
+
+#endif
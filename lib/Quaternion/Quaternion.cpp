@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Quaternion.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Quaternion.h"
+
+// atan(2^-i) as a fraction of a turn, 2^32 per turn
+static const int32_t cordicAtan[QUAT_CORDIC_ITERATIONS] = {
+  0x20000000, 0x12E4051E, 0x09FB385B, 0x051111D4, 0x028B0D43, 0x0145D7E1, 0x00A2F61E, 0x00517C55,
+  0x0028BE53, 0x00145F2F, 0x000A2F98, 0x000517CC, 0x00028BE6, 0x000145F3, 0x0000A2FA, 0x0000517D,
+  0x000028BE, 0x0000145F, 0x00000A30, 0x00000518
+};
+
+#define CORDIC_INV_GAIN 652032874L // 1 / 1.64676 (CORDIC gain after 20 steps) in Q30
+#define DELTANG_PI_Q29 1686629713L // pi in Q29. One DELTANG LSB is pi / 2^29 rad, so half of it is pi in Q30.
+#define INVSQRT_CHORD0 1252698795L // 7/6 in Q30, the chord of 1/sqrt(a) from a = 1 to 4 at a = 0
+#define INVSQRT_CHORD1 178956971L // 1/6 in Q30, the slope of that chord
+
+// Q30 product, rounded to nearest
+static inline int32_t mulQ30(int32_t a, int32_t b) {
+  return((int32_t)(((int64_t)a * b + (1L << 29)) >> 30));
+}
+
+// Q60 sum of products back to Q30, rounded to nearest
+static inline int32_t roundQ60(int64_t v) {
+  return((int32_t)((v + (1L << 29)) >> 30));
+}
+
+// 1/sqrt(a) in Q30 for a Q30 value from 1 to 4: the chord through both
+// ends, then four Newton steps, leaving under 1e-8 of relative error
+static int32_t invSqrtQ30(int64_t a) {
+  int64_t y = INVSQRT_CHORD0 - ((INVSQRT_CHORD1 * a) >> 30);
+  for (int i = 0; i < 4; ++i) {
+    int64_t y2 = (y * y) >> 30;
+    y = (y * ((3LL << 30) - ((a * y2) >> 30))) >> 31;
+  }
+  return((int32_t)y);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Vectoring CORDIC: the angle of (x, y) as a fraction of a turn (2^32 per
+// turn) and its length times the CORDIC gain. Inputs are Q29 so the gain
+// cannot overflow.
+////////////////////////////////////////////////////////////////////////////
+static uint32_t cordicAtan2(int32_t y, int32_t x, int32_t &length) {
+  uint32_t angle = 0;
+  if (x < 0) { // Rotate by half a turn into the right half plane
+    x = -x;
+    y = -y;
+    angle = 0x80000000UL;
+  }
+  for (int i = 0; i < QUAT_CORDIC_ITERATIONS; ++i) {
+    int32_t dx = y >> i;
+    int32_t dy = x >> i;
+    if (y > 0) {
+      x += dx;
+      y -= dy;
+      angle += cordicAtan[i];
+    }
+    else {
+      x -= dx;
+      y += dy;
+      angle -= cordicAtan[i];
+    }
+  }
+  length = x;
+  return(angle);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Rotation CORDIC: Q30 cosine and sine of angle (2^32 per turn), which
+// must be within a quarter turn of zero
+////////////////////////////////////////////////////////////////////////////
+static void cordicSinCos(int32_t angle, int32_t &c, int32_t &s) {
+  int32_t x = CORDIC_INV_GAIN;
+  int32_t y = 0;
+  for (int i = 0; i < QUAT_CORDIC_ITERATIONS; ++i) {
+    int32_t dx = y >> i;
+    int32_t dy = x >> i;
+    if (angle >= 0) {
+      x -= dx;
+      y += dy;
+      angle -= cordicAtan[i];
+    }
+    else {
+      x += dx;
+      y -= dy;
+      angle += cordicAtan[i];
+    }
+  }
+  c = x;
+  s = y;
+}
+
+// Fraction of a turn (2^32 per turn) to the ADIS16480 Euler format (2^16 per turn), rounded
+static inline int16_t eulerFromTurn(uint32_t angle) {
+  return((int16_t)(uint16_t)((angle + 0x8000UL) >> 16));
+}
+
+void quatIdentity(Quaternion &q) {
+  q.w = QUAT_ONE;
+  q.x = 0;
+  q.y = 0;
+  q.z = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void quatMultiply(const Quaternion &a, const Quaternion &b, Quaternion &out)
+////////////////////////////////////////////////////////////////////////////
+// Each component sums four Q60 products in 64 bits and rounds once.
+////////////////////////////////////////////////////////////////////////////
+// a - left operand
+// b - right operand
+// out - receives a * b, may be a or b
+////////////////////////////////////////////////////////////////////////////
+void quatMultiply(const Quaternion &a, const Quaternion &b, Quaternion &out) {
+  int32_t w = roundQ60((int64_t)a.w * b.w - (int64_t)a.x * b.x - (int64_t)a.y * b.y - (int64_t)a.z * b.z);
+  int32_t x = roundQ60((int64_t)a.w * b.x + (int64_t)a.x * b.w + (int64_t)a.y * b.z - (int64_t)a.z * b.y);
+  int32_t y = roundQ60((int64_t)a.w * b.y - (int64_t)a.x * b.z + (int64_t)a.y * b.w + (int64_t)a.z * b.x);
+  int32_t z = roundQ60((int64_t)a.w * b.z + (int64_t)a.x * b.y - (int64_t)a.y * b.x + (int64_t)a.z * b.w);
+  out.w = w;
+  out.x = x;
+  out.y = y;
+  out.z = z;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Scales q by (3 - |q|^2) / 2, one Newton step towards 1 / |q|. A norm
+// error e becomes about 1.5 e^2, so rounding never accumulates.
+////////////////////////////////////////////////////////////////////////////
+void quatNormalize(Quaternion &q) {
+  int32_t n = roundQ60((int64_t)q.w * q.w + (int64_t)q.x * q.x + (int64_t)q.y * q.y + (int64_t)q.z * q.z);
+  int32_t scale = (int32_t)((3 * (int64_t)QUAT_ONE - n) >> 1);
+  q.w = mulQ30(q.w, scale);
+  q.x = mulQ30(q.x, scale);
+  q.y = mulQ30(q.y, scale);
+  q.z = mulQ30(q.z, scale);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void quatDeltaAngle(const int32_t deltAng[3], Quaternion &dq)
+////////////////////////////////////////////////////////////////////////////
+// dq = [cos(|h|), sin(|h|) h / |h|] with h half the delta angle vector,
+// using cos(a) = 1 - a^2/2 + a^4/24 and sin(a)/a = 1 - a^2/6 + a^4/120.
+// The length of h is clipped to 1 rad (115 deg of rotation per sample),
+// keeping its direction, where the series still holds.
+////////////////////////////////////////////////////////////////////////////
+// deltAng - raw X/Y/Z_DELTANG_OUT:X/Y/Z_DELTANG_LOW
+// dq - receives the rotation over the sample
+////////////////////////////////////////////////////////////////////////////
+void quatDeltaAngle(const int32_t deltAng[3], Quaternion &dq) {
+  int64_t v[3];
+  int64_t largest = 0;
+  for (int i = 0; i < 3; ++i) {
+    v[i] = ((int64_t)deltAng[i] * DELTANG_PI_Q29 + (1L << 28)) >> 29; // Up to 2 pi, more than Q30 holds
+    int64_t m = v[i] < 0 ? -v[i] : v[i];
+    largest = m > largest ? m : largest;
+  }
+  int shift = 0;
+  while ((largest >> shift) > QUAT_ONE) { // At most 3 steps. A common shift keeps the direction.
+    ++shift;
+  }
+  int32_t h[3];
+  for (int i = 0; i < 3; ++i) {
+    h[i] = (int32_t)(v[i] >> shift);
+  }
+  int64_t a2Q60 = (int64_t)h[0] * h[0] + (int64_t)h[1] * h[1] + (int64_t)h[2] * h[2]; // Up to 3.0
+  if (shift > 0 || a2Q60 > ((int64_t)QUAT_ONE << 30)) {
+    if (a2Q60 < ((int64_t)QUAT_ONE << 30)) { // Shifted below 1 rad, but never below 0.5
+      for (int i = 0; i < 3; ++i) {
+        h[i] *= 2;
+      }
+      a2Q60 *= 4;
+    }
+    int32_t scale = invSqrtQ30((a2Q60 + (1L << 29)) >> 30);
+    for (int i = 0; i < 3; ++i) {
+      h[i] = mulQ30(h[i], scale);
+    }
+    a2Q60 = (int64_t)h[0] * h[0] + (int64_t)h[1] * h[1] + (int64_t)h[2] * h[2];
+  }
+  int32_t a2 = roundQ60(a2Q60);
+  int32_t a4 = mulQ30(a2, a2);
+  dq.w = QUAT_ONE - (a2 >> 1) + a4 / 24;
+  int32_t sinc = QUAT_ONE - a2 / 6 + a4 / 120;
+  dq.x = mulQ30(h[0], sinc);
+  dq.y = mulQ30(h[1], sinc);
+  dq.z = mulQ30(h[2], sinc);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void quatIntegrate(Quaternion &q, const int32_t deltAng[3])
+////////////////////////////////////////////////////////////////////////////
+// One strapdown attitude update. Delta angles are body frame rotations,
+// so the sample's rotation is applied on the right.
+////////////////////////////////////////////////////////////////////////////
+// q - attitude, updated in place
+// deltAng - raw X/Y/Z_DELTANG_OUT:X/Y/Z_DELTANG_LOW of the sample
+////////////////////////////////////////////////////////////////////////////
+void quatIntegrate(Quaternion &q, const int32_t deltAng[3]) {
+  Quaternion dq;
+  quatDeltaAngle(deltAng, dq);
+  quatMultiply(q, dq, q);
+  quatNormalize(q);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void quatToEuler(const Quaternion &q, int16_t euler[3])
+////////////////////////////////////////////////////////////////////////////
+// roll = atan2(2(wx + yz), 1 - 2(x^2 + y^2))
+// pitch = atan2(2(wy - xz), cos(pitch)), cos(pitch) being the length of
+//         the roll vector, which the roll CORDIC leaves behind
+// yaw = atan2(2(wz + xy), 1 - 2(y^2 + z^2))
+// Pitch stays accurate near +/-90 deg, where asin() would not.
+////////////////////////////////////////////////////////////////////////////
+// q - unit attitude quaternion
+// euler - receives roll, pitch, yaw (180/32768 deg per LSB)
+////////////////////////////////////////////////////////////////////////////
+void quatToEuler(const Quaternion &q, int16_t euler[3]) {
+  // Q29 terms, so the CORDIC gain has headroom
+  int32_t sinRoll = roundQ60((int64_t)q.w * q.x + (int64_t)q.y * q.z);
+  int32_t cosRoll = (QUAT_ONE >> 1) - roundQ60((int64_t)q.x * q.x + (int64_t)q.y * q.y);
+  int32_t sinPitch = roundQ60((int64_t)q.w * q.y - (int64_t)q.x * q.z);
+  int32_t sinYaw = roundQ60((int64_t)q.w * q.z + (int64_t)q.x * q.y);
+  int32_t cosYaw = (QUAT_ONE >> 1) - roundQ60((int64_t)q.y * q.y + (int64_t)q.z * q.z);
+
+  int32_t length;
+  euler[0] = eulerFromTurn(cordicAtan2(sinRoll, cosRoll, length));
+  int32_t cosPitch = mulQ30(length, CORDIC_INV_GAIN);
+  euler[1] = eulerFromTurn(cordicAtan2(sinPitch, cosPitch, length));
+  euler[2] = eulerFromTurn(cordicAtan2(sinYaw, cosYaw, length));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void quatFromEuler(const int16_t euler[3], Quaternion &q)
+////////////////////////////////////////////////////////////////////////////
+// euler - roll, pitch, yaw (180/32768 deg per LSB)
+// q - receives the unit attitude quaternion
+////////////////////////////////////////////////////////////////////////////
+void quatFromEuler(const int16_t euler[3], Quaternion &q) {
+  // Half angles, 2^32 per turn, all within a quarter turn
+  int32_t cr, sr, cp, sp, cy, sy;
+  cordicSinCos((int32_t)euler[0] * 32768, cr, sr);
+  cordicSinCos((int32_t)euler[1] * 32768, cp, sp);
+  cordicSinCos((int32_t)euler[2] * 32768, cy, sy);
+
+  int32_t crcp = mulQ30(cr, cp);
+  int32_t srsp = mulQ30(sr, sp);
+  int32_t srcp = mulQ30(sr, cp);
+  int32_t crsp = mulQ30(cr, sp);
+  q.w = mulQ30(crcp, cy) + mulQ30(srsp, sy);
+  q.x = mulQ30(srcp, cy) - mulQ30(crsp, sy);
+  q.y = mulQ30(crsp, cy) + mulQ30(srcp, sy);
+  q.z = mulQ30(crcp, sy) - mulQ30(srsp, cy);
+  quatNormalize(q);
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Quaternion.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Fixed-point attitude quaternions for the Cortex-M4, which has no FPU. Components are Q30 (1.0 is
+//  2^30), products are accumulated in 64 bits (one SMLAL each), and nothing divides or loops more
+//  than a fixed number of times, so an update costs the same every sample.
+//
+//  quatIntegrate() turns the raw X/Y/Z_DELTANG registers of one sample into a rotation and applies
+//  it in the body frame, so the attitude keeps up at the native output rate whatever DEC_RATE is.
+//  quatToEuler() and quatFromEuler() use the aerospace Z-Y-X (yaw, pitch, roll) sequence and the
+//  ROLL_C23_OUT/PITCH_C31_OUT/YAW_C32_OUT format (180/32768 deg per LSB), so either attitude fits
+//  the same telemetry records.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef Quaternion_h
+#define Quaternion_h
+
+#include <stdint.h>
+
+#define QUAT_ONE 0x40000000L // 1.0 in Q30
+#define QUAT_CORDIC_ITERATIONS 20 // CORDIC steps, leaving under 0.02 LSB of Euler output error
+
+// Attitude quaternion, w + xi + yj + zk, each component Q30
+struct Quaternion {
+  int32_t w;
+  int32_t x;
+  int32_t y;
+  int32_t z;
+};
+
+// Set q to no rotation
+void quatIdentity(Quaternion &q);
+
+// out = a * b (Hamilton product, rotation b applied in the frame of a). out may alias a or b.
+void quatMultiply(const Quaternion &a, const Quaternion &b, Quaternion &out);
+
+// Pull q back to unit length with one Newton step. q must already be close to unit length
+// (within a few percent), as it is after any number of quatIntegrate() calls.
+void quatNormalize(Quaternion &q);
+
+// Rotation of one sample from the raw X/Y/Z_DELTANG_OUT:LOW registers (720 deg full scale).
+// Series expansion to 4th order in the angle, so its error is below Q30 resolution up to about
+// 10 deg per sample. Larger rotations are clipped to 115 deg per sample about the same axis.
+void quatDeltaAngle(const int32_t deltAng[3], Quaternion &dq);
+
+// Apply one sample of delta angles to q and renormalize
+void quatIntegrate(Quaternion &q, const int32_t deltAng[3]);
+
+// Roll, pitch, yaw of q in the ADIS16480 Euler format
+void quatToEuler(const Quaternion &q, int16_t euler[3]);
+
+// q from roll, pitch, yaw in the ADIS16480 Euler format, e.g. to start from the on-chip EKF
+void quatFromEuler(const int16_t euler[3], Quaternion &q);
+
+#endif
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SPIBus.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SPIBus.h"
+
+// SPI_MODEn constants keep CPOL in bit 3 on both the Teensy and the host
+#define SPIBUS_CPOL 0x08
+
+////////////////////////////////////////////////////////////////////////////
+// SPIBus(SPITransport &bus)
+////////////////////////////////////////////////////////////////////////////
+// bus - SPI/GPIO transport shared by every registered device
+////////////////////////////////////////////////////////////////////////////
+SPIBus::SPIBus(SPITransport &bus) : _bus(bus) {
+}
+
+////////////////////////////////////////////////////////////////////////////
+// int addDevice(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+////////////////////////////////////////////////////////////////////////////
+// clock - SCK frequency [Hz]
+// bitOrder - MSBFIRST or LSBFIRST
+// dataMode - SPI_MODE0..SPI_MODE3
+// return - device handle for begin() and queue(), -1 if the table is full
+////////////////////////////////////////////////////////////////////////////
+int SPIBus::addDevice(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+  if (_deviceCount >= SPIBUS_MAX_DEVICES) {
+    return(-1);
+  }
+  for (int i = 0; i < SPIBUS_PROFILES; ++i) {
+    _devices[_deviceCount].clock[i] = clock;
+  }
+  _devices[_deviceCount].bitOrder = bitOrder;
+  _devices[_deviceCount].dataMode = dataMode;
+  return(_deviceCount++);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void setClock(int device, uint8_t profile, uint32_t clock)
+////////////////////////////////////////////////////////////////////////////
+// device - handle returned by addDevice()
+// profile - SPIBUS_CONFIG or SPIBUS_DATA
+// clock - SCK frequency [Hz], used from the next begin()
+////////////////////////////////////////////////////////////////////////////
+void SPIBus::setClock(int device, uint8_t profile, uint32_t clock) {
+  _devices[device].clock[profile] = clock;
+}
+
+uint32_t SPIBus::clock(int device, uint8_t profile) {
+  return(_devices[device].clock[profile]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Finds the fastest SPIBUS_DATA clock a device reads back reliably
+////////////////////////////////////////////////////////////////////////////////////////////
+// Tries the rates in clocks, lowest first. At each rate check runs soak
+// times inside one transaction; the first error stops the search. The
+// highest rate that passed every check is stored in the device's
+// SPIBUS_DATA profile. If none passed, the profile is left as it was.
+//
+// Opt-in and meant for bring-up: a rate past the device's limit may also
+// garble what the device receives, so checks should only read, and the
+// device should be reconfigured afterwards if the probe failed early.
+////////////////////////////////////////////////////////////////////////////////////////////
+// device - handle returned by addDevice()
+// check - reads a register with a known value and compares it
+// arg - passed to check
+// clocks - candidate rates [Hz], ascending
+// n - number of candidate rates
+// soak - checks that must pass at each rate
+// return - (uint32_t) rate stored, 0 if none passed
+////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SPIBus::probe(int device, SPIBusCheck check, void* arg, const uint32_t* clocks, int n, unsigned long soak) {
+  uint32_t original = _devices[device].clock[SPIBUS_DATA];
+  uint32_t best = 0;
+  for (int i = 0; i < n; ++i) {
+    setClock(device, SPIBUS_DATA, clocks[i]);
+    begin(device, SPIBUS_DATA);
+    bool passed = true;
+    for (unsigned long j = 0; j < soak && passed; ++j) {
+      passed = check(arg);
+    }
+    end();
+    if (!passed) {
+      break;
+    }
+    best = clocks[i];
+  }
+  setClock(device, SPIBUS_DATA, best ? best : original);
+  return(best);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void begin(int device, uint8_t profile)
+////////////////////////////////////////////////////////////////////////////
+// Starts a transaction with device's settings. The bookkeeping happens
+// after beginTransaction(), once an ISR sharing the bus is masked. A dummy
+// transfer (CS not asserted) is only sent when the clock polarity changes,
+// so SCK sits at its new idle level before the device is selected.
+////////////////////////////////////////////////////////////////////////////
+// device - handle returned by addDevice()
+// profile - SPIBUS_CONFIG or SPIBUS_DATA
+////////////////////////////////////////////////////////////////////////////
+void SPIBus::begin(int device, uint8_t profile) {
+  const Device &d = _devices[device];
+  uint32_t clock = d.clock[profile];
+  _bus.beginTransaction(clock, d.bitOrder, d.dataMode);
+  uint32_t now = _bus.micros();
+  if (_ended) {
+    _stats.idleMicros += now - _endMicros;
+  }
+  _beginMicros = now;
+  _active = true;
+  ++_stats.transactions;
+
+  if (_wireValid && _wire.clock == clock && _wire.bitOrder == d.bitOrder && _wire.dataMode == d.dataMode) {
+    ++_stats.switchesSkipped; // Same settings, possibly under another device or profile
+  } else {
+    ++_stats.modeSwitches;
+    if (!_wireValid || ((_wire.dataMode ^ d.dataMode) & SPIBUS_CPOL)) {
+      _bus.transfer(0x00); // Dummy write to force the SCK idle level change
+      ++_stats.dummyWrites;
+    }
+    _wire.clock = clock;
+    _wire.bitOrder = d.bitOrder;
+    _wire.dataMode = d.dataMode;
+    _wireValid = true;
+  }
+  _loaded = device;
+  _loadedProfile = profile;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void end()
+////////////////////////////////////////////////////////////////////////////
+// Ends the current transaction. The settings stay loaded, so the next
+// begin() for the same device does not switch modes.
+////////////////////////////////////////////////////////////////////////////
+void SPIBus::end() {
+  if (!_active) {
+    return;
+  }
+  uint32_t now = _bus.micros();
+  _stats.busyMicros += now - _beginMicros;
+  _endMicros = now;
+  _ended = true;
+  _active = false;
+  _bus.endTransaction();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// bool queue(int device, SPIBusJob job, void* arg, uint8_t profile)
+////////////////////////////////////////////////////////////////////////////
+// device - handle returned by addDevice()
+// job - function doing the device's SPI work; it must not call begin()/end()
+// arg - passed to job
+// profile - SPIBUS_CONFIG or SPIBUS_DATA
+// return - false if the queue is full
+////////////////////////////////////////////////////////////////////////////
+bool SPIBus::queue(int device, SPIBusJob job, void* arg, uint8_t profile) {
+  if (_jobCount >= SPIBUS_MAX_JOBS || device < 0 || device >= _deviceCount || profile >= SPIBUS_PROFILES) {
+    return(false);
+  }
+  _jobs[_jobCount].device = device;
+  _jobs[_jobCount].profile = profile;
+  _jobs[_jobCount].job = job;
+  _jobs[_jobCount].arg = arg;
+  ++_jobCount;
+  return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// Runs every queued job grouped by device and clock profile
+////////////////////////////////////////////////////////////////////////////////////////////
+// The device and profile already loaded go first, then every other pair once
+// in order of first appearance, so each pair costs at most one mode switch.
+// Jobs for the same pair keep their relative order and share one
+// transaction. Reordering across devices is only safe when no job depends
+// on a job queued for another device.
+////////////////////////////////////////////////////////////////////////////////////////////
+// return - (int) number of mode switches made
+////////////////////////////////////////////////////////////////////////////////////////////
+int SPIBus::run() {
+  unsigned long switches = _stats.modeSwitches;
+  bool visited[SPIBUS_MAX_DEVICES][SPIBUS_PROFILES] = {{false}};
+  for (int i = -1; i < _jobCount; ++i) {
+    int device = (i < 0) ? _loaded : _jobs[i].device;
+    uint8_t profile = (i < 0) ? _loadedProfile : _jobs[i].profile;
+    if (device < 0 || visited[device][profile]) {
+      continue;
+    }
+    visited[device][profile] = true;
+
+    bool open = false;
+    for (int j = (i < 0) ? 0 : i; j < _jobCount; ++j) {
+      if (_jobs[j].device != device || _jobs[j].profile != profile) {
+        continue;
+      }
+      if (!open) {
+        begin(device, profile);
+        open = true;
+      }
+      _jobs[j].job(_jobs[j].arg);
+    }
+    if (open) {
+      end();
+    }
+  }
+  _jobCount = 0;
+  return((int)(_stats.modeSwitches - switches));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// const SPIBusCounters &stats()
+////////////////////////////////////////////////////////////////////////////
+// Usage counters since the last clearStats(). Dividing by the number of
+// samples taken over the same period gives the per-sample cost.
+////////////////////////////////////////////////////////////////////////////
+const SPIBusCounters &SPIBus::stats() {
+  return(_stats);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void clearStats()
+////////////////////////////////////////////////////////////////////////////
+// Resets the usage counters
+////////////////////////////////////////////////////////////////////////////
+void SPIBus::clearStats() {
+  SPIBusCounters cleared = {0, 0, 0, 0, 0, 0};
+  _stats = cleared;
+}
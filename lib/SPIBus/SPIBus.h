@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SPIBus.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Arbiter for devices sharing one SPI bus with different settings. Each device registers its clock,
+//  bit order, and data mode once, and may run faster for output data (SPIBUS_DATA) than for
+//  configuration and flash writes (SPIBUS_CONFIG). The arbiter remembers which settings are on the wire, so the
+//  dummy transfer that moves SCK to a new idle level is only paid when the clock polarity actually
+//  changes. Work for several devices can be queued and is then run grouped by device, starting with
+//  the device whose settings are already loaded.
+//
+//  beginTransaction()/endTransaction() are still issued around every access: on the Teensy they
+//  mask the interrupts registered with SPI.usingInterrupt(), which keeps an ISR off the bus while
+//  loop() is using it.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPIBus_h
+#define SPIBus_h
+
+#include "SPITransport.h"
+
+#define SPIBUS_MAX_DEVICES 4 // Devices that can be registered
+#define SPIBUS_MAX_JOBS 8 // Jobs that can wait in the queue
+
+// Clock profiles, one SCK rate per operation class
+#define SPIBUS_CONFIG 0 // Configuration and flash writes, the default
+#define SPIBUS_DATA 1 // Output register reads, packet transfers
+#define SPIBUS_PROFILES 2
+
+// Work run with a device selected by SPIBus::run()
+typedef void (*SPIBusJob)(void* arg);
+
+// Link test run by SPIBus::probe(). Returns true if a known register read back correctly.
+typedef bool (*SPIBusCheck)(void* arg);
+
+// Bus usage counters, cleared by SPIBus::clearStats()
+struct SPIBusCounters {
+  unsigned long transactions; // begin()/end() pairs
+  unsigned long modeSwitches; // Transactions that loaded different settings
+  unsigned long switchesSkipped; // Transactions that found their settings already loaded
+  unsigned long dummyWrites; // Dummy transfers issued to settle SCK after a polarity change
+  uint32_t busyMicros; // Time spent inside transactions
+  uint32_t idleMicros; // Time between transactions
+};
+
+// SPIBus class definition
+class SPIBus {
+
+public:
+#if defined(ARDUINO)
+  SPIBus(SPITransport &bus = TeensySPI);
+#else
+  SPIBus(SPITransport &bus);
+#endif
+
+  // Register a device's settings, clock used by every profile. Returns its handle, or -1 if the table is full.
+  int addDevice(uint32_t clock, uint8_t bitOrder, uint8_t dataMode);
+
+  // Set the SCK rate of one of a device's clock profiles
+  void setClock(int device, uint8_t profile, uint32_t clock);
+
+  // SCK rate of one of a device's clock profiles
+  uint32_t clock(int device, uint8_t profile);
+
+  // Raise the SPIBUS_DATA clock step by step while check passes. Returns the rate kept, 0 if none passed.
+  uint32_t probe(int device, SPIBusCheck check, void* arg, const uint32_t* clocks, int n, unsigned long soak);
+
+  // Start a transaction with device's settings, switching modes only if needed
+  void begin(int device, uint8_t profile = SPIBUS_CONFIG);
+
+  // End the current transaction
+  void end();
+
+  // Queue job to run with device selected. Returns false if the queue is full.
+  bool queue(int device, SPIBusJob job, void* arg = 0, uint8_t profile = SPIBUS_CONFIG);
+
+  // Run every queued job, grouped by device and profile. Returns the number of mode switches.
+  int run();
+
+  // Usage counters since the last clearStats()
+  const SPIBusCounters &stats();
+
+  // Reset the usage counters
+  void clearStats();
+
+private:
+  struct Device {
+    uint32_t clock[SPIBUS_PROFILES];
+    uint8_t bitOrder;
+    uint8_t dataMode;
+  };
+
+  struct Job {
+    int device;
+    uint8_t profile;
+    SPIBusJob job;
+    void* arg;
+  };
+
+  // SPI/GPIO transport
+  SPITransport &_bus;
+
+  // Registered devices
+  Device _devices[SPIBUS_MAX_DEVICES];
+  int _deviceCount = 0;
+
+  // Queued jobs, in the order they were queued
+  Job _jobs[SPIBUS_MAX_JOBS];
+  int _jobCount = 0;
+
+  // Device and profile that used the bus last, -1 before the first transaction
+  int _loaded = -1;
+  uint8_t _loadedProfile = SPIBUS_CONFIG;
+
+  // Settings on the wire
+  struct {
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+  } _wire = {0, 0, 0};
+  bool _wireValid = false;
+
+  // Time the current transaction started and the last one ended
+  uint32_t _beginMicros = 0;
+  uint32_t _endMicros = 0;
+  bool _active = false;
+  bool _ended = false;
+
+  SPIBusCounters _stats = {0, 0, 0, 0, 0, 0};
+
+};
+
+#endif
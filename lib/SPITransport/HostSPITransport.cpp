@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host (Linux) build only
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HostSPITransport.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO)
+
+#include "HostSPITransport.h"
+
+HostSPITransport::HostSPITransport()
+  : _selected(0), _selectedMax(0), _recording(true), _clock(1000000), _dataMode(SPI_MODE0), _now(0), _statsStart(0) {
+  resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void attach(int cs, SPIDevice *dev, uint32_t maxClock)
+////////////////////////////////////////////////////////////////////////////
+// Routes a chip select pin to a simulated slave. Driving the pin low
+// opens a frame, driving it high closes and records it.
+////////////////////////////////////////////////////////////////////////////
+// cs - chip select pin used by the driver
+// dev - simulated slave
+// maxClock - fastest SCK rate the slave keeps up with [Hz], 0 for any
+////////////////////////////////////////////////////////////////////////////
+void HostSPITransport::attach(int cs, SPIDevice *dev, uint32_t maxClock) {
+  Route r = {cs, dev, true, maxClock};
+  _routes.push_back(r);
+}
+
+void HostSPITransport::attachPin(int pin, SPIDevice *dev) {
+  Route r = {pin, dev, false, 0};
+  _routes.push_back(r);
+}
+
+void HostSPITransport::setRecording(bool enable) {
+  _recording = enable;
+}
+
+const std::vector<SPIFrame> &HostSPITransport::frames() const {
+  return(_frames);
+}
+
+void HostSPITransport::clearFrames() {
+  _frames.clear();
+}
+
+SPIBusStats HostSPITransport::stats() const {
+  SPIBusStats s = _stats;
+  s.elapsedNs = _now - _statsStart;
+  return(s);
+}
+
+void HostSPITransport::resetStats() {
+  SPIBusStats zero = {0, 0, 0, 0, 0, 0, 0};
+  _stats = zero;
+  _statsStart = _now;
+}
+
+uint64_t HostSPITransport::nowNs() const {
+  return(_now);
+}
+
+void HostSPITransport::advance(uint64_t ns) {
+  _now += ns;
+}
+
+HostSPITransport::Route *HostSPITransport::findRoute(int pin) {
+  for (size_t i = 0; i < _routes.size(); ++i) {
+    if (_routes[i].pin == pin) {
+      return(&_routes[i]);
+    }
+  }
+  return(0);
+}
+
+void HostSPITransport::pinMode(int pin, int mode) {
+  // Pin direction has no effect on the model
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void digitalWrite(int pin, int level)
+////////////////////////////////////////////////////////////////////////////
+// Opens or closes frames on chip select pins and forwards every other
+// routed pin to its device.
+////////////////////////////////////////////////////////////////////////////
+void HostSPITransport::digitalWrite(int pin, int level) {
+  Route *r = findRoute(pin);
+  if (r == 0) {
+    return;
+  }
+  if (!r->isCS) {
+    r->dev->pinWrite(pin, level, _now);
+    return;
+  }
+  if (level == LOW && _selected == 0) {
+    _selected = r->dev;
+    _selectedMax = r->maxClock;
+    _open.cs = pin;
+    _open.startNs = _now;
+    _open.clock = _clock;
+    _open.dataMode = _dataMode;
+    _open.mosi.clear();
+    _open.miso.clear();
+    _selected->select(_now, _clock, _dataMode);
+  } else if (level == HIGH && _selected == r->dev) {
+    _open.endNs = _now;
+    _selected->deselect(_now);
+    _selected = 0;
+    _stats.frames++;
+    if (_recording) {
+      _frames.push_back(_open);
+    }
+  }
+}
+
+int HostSPITransport::digitalRead(int pin) {
+  Route *r = findRoute(pin);
+  return(r ? r->dev->pinRead(pin, _now) : LOW);
+}
+
+void HostSPITransport::beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+  _clock = clock;
+  _dataMode = dataMode;
+}
+
+void HostSPITransport::endTransaction() {
+}
+
+////////////////////////////////////////////////////////////////////////////
+// uint8_t transfer(uint8_t data)
+////////////////////////////////////////////////////////////////////////////
+// Exchanges one byte with the selected device and advances modeled time
+// by 8 SCK periods. With no device selected MISO floats high. Past the
+// device's maximum clock the byte read back is shifted by one bit.
+////////////////////////////////////////////////////////////////////////////
+uint8_t HostSPITransport::transfer(uint8_t data) {
+  uint64_t byteNs = (8ULL * 1000000000ULL + _clock - 1) / _clock;
+  _now += byteNs;
+  _stats.busyNs += byteNs;
+  if (_selected == 0) {
+    _stats.strayBytes++;
+    return(0xFF);
+  }
+  uint8_t rx = _selected->exchange(data);
+  if (_selectedMax && _clock > _selectedMax) {
+    rx = (uint8_t)((rx << 1) | 0x01); // Each bit sampled one period late
+  }
+  _stats.bytes++;
+  if (_recording) {
+    _open.mosi.push_back(data);
+    _open.miso.push_back(rx);
+  }
+  return(rx);
+}
+
+void HostSPITransport::end() {
+}
+
+void HostSPITransport::delayMicroseconds(uint32_t us) {
+  _now += 1000ULL * us;
+  _stats.stallNs += 1000ULL * us;
+}
+
+void HostSPITransport::delay(uint32_t ms) {
+  _now += 1000000ULL * ms;
+  _stats.sleepNs += 1000000ULL * ms;
+}
+
+uint32_t HostSPITransport::micros() {
+  return((uint32_t)(_now / 1000ULL));
+}
+
+#endif
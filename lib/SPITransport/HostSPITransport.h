@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Host (Linux) build only
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HostSPITransport.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Host backend for SPITransport. Time is modeled, not measured: every transferred byte advances a
+//  virtual clock by 8 SCK periods at the current transaction clock, and every delay advances it by the
+//  requested amount. Each CS-low to CS-high window is recorded as an SPIFrame with start and end
+//  timestamps so transactions, bus-idle time, and stall overhead can be measured per sample.
+//
+//  Simulated slaves implement SPIDevice and are attached to their chip select pin, optionally with
+//  the highest SCK rate they keep up with. Above it every byte read back is shifted by one bit, as
+//  when MISO is sampled before the slave has driven it, so clock probing can be exercised on the host.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HostSPITransport_h
+#define HostSPITransport_h
+
+#if !defined(ARDUINO)
+
+#include <vector>
+#include "SPITransport.h"
+
+// Simulated SPI slave
+class SPIDevice {
+public:
+  virtual ~SPIDevice() {}
+
+  // CS went low at time nowNs with the given bus settings
+  virtual void select(uint64_t nowNs, uint32_t clock, uint8_t dataMode) {}
+
+  // Exchange one byte while selected
+  virtual uint8_t exchange(uint8_t mosi) = 0;
+
+  // CS went high at time nowNs
+  virtual void deselect(uint64_t nowNs) {}
+
+  // A non-CS pin routed to this device was driven (reset lines)
+  virtual void pinWrite(int pin, int level, uint64_t nowNs) {}
+
+  // A non-CS pin routed to this device was read (data ready, IRQ lines)
+  virtual int pinRead(int pin, uint64_t nowNs) { return(LOW); }
+};
+
+// One recorded CS-low to CS-high window
+struct SPIFrame {
+  int cs;               // Chip select pin
+  uint64_t startNs;     // CS falling edge
+  uint64_t endNs;       // CS rising edge
+  uint32_t clock;       // SCK rate in Hz
+  uint8_t dataMode;     // SPI_MODE0..3
+  std::vector<uint8_t> mosi;
+  std::vector<uint8_t> miso;
+};
+
+// Bus counters accumulated since the last resetStats()
+struct SPIBusStats {
+  uint64_t frames;      // CS-framed transactions
+  uint64_t bytes;       // Bytes exchanged inside frames
+  uint64_t strayBytes;  // Bytes exchanged with no CS asserted (dummy writes)
+  uint64_t busyNs;      // Time spent clocking bytes
+  uint64_t stallNs;     // Time spent in delayMicroseconds()
+  uint64_t sleepNs;     // Time spent in delay()
+  uint64_t elapsedNs;   // Modeled time since resetStats()
+
+  // Time the bus spent neither clocking nor stalling
+  uint64_t idleNs() const { return(elapsedNs - busyNs - stallNs - sleepNs); }
+};
+
+// HostSPITransport class definition
+class HostSPITransport : public SPITransport {
+public:
+  HostSPITransport();
+
+  // Route a chip select pin to a simulated slave that handles up to maxClock Hz (0 = any rate)
+  void attach(int cs, SPIDevice *dev, uint32_t maxClock = 0);
+
+  // Route a non-CS pin (reset, data ready, IRQ) to a simulated slave
+  void attachPin(int pin, SPIDevice *dev);
+
+  // Enable or disable per-frame recording. Counters are always kept.
+  void setRecording(bool enable);
+
+  // Recorded frames, oldest first
+  const std::vector<SPIFrame> &frames() const;
+
+  // Forget recorded frames
+  void clearFrames();
+
+  // Counters since the last resetStats()
+  SPIBusStats stats() const;
+
+  // Clear counters and restart the elapsed time measurement
+  void resetStats();
+
+  // Current modeled time
+  uint64_t nowNs() const;
+
+  // Advance modeled time without any bus activity (CPU work, waiting for an edge)
+  void advance(uint64_t ns);
+
+  // SPITransport interface
+  void pinMode(int pin, int mode);
+  void digitalWrite(int pin, int level);
+  int digitalRead(int pin);
+  void beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+  void end();
+  void delayMicroseconds(uint32_t us);
+  void delay(uint32_t ms);
+  uint32_t micros();
+
+private:
+  struct Route {
+    int pin;
+    SPIDevice *dev;
+    bool isCS;
+    uint32_t maxClock;
+  };
+
+  // Look up the device routed to a pin
+  Route *findRoute(int pin);
+
+  std::vector<Route> _routes;
+  std::vector<SPIFrame> _frames;
+  SPIFrame _open;           // Frame being assembled while CS is low
+  SPIDevice *_selected;     // Device whose CS is currently low
+  uint32_t _selectedMax;    // Highest SCK rate of the selected device, 0 = any
+  bool _recording;
+  uint32_t _clock;
+  uint8_t _dataMode;
+  uint64_t _now;
+  uint64_t _statsStart;
+  SPIBusStats _stats;
+};
+
+#endif
+
+#endif
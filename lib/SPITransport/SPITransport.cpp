@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SPITransport.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SPITransport.h"
+
+#if defined(ARDUINO)
+
+// Constant-initialized so drivers constructed at global scope can use it safely
+TeensySPITransport TeensySPI;
+
+void TeensySPITransport::pinMode(int pin, int mode) {
+  ::pinMode(pin, mode);
+}
+
+void TeensySPITransport::digitalWrite(int pin, int level) {
+  ::digitalWrite(pin, level);
+}
+
+int TeensySPITransport::digitalRead(int pin) {
+  return(::digitalRead(pin));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// void beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+////////////////////////////////////////////////////////////////////////////
+// Loads SPI settings. Also masks any interrupt registered with
+// SPI.usingInterrupt() until endTransaction() is called.
+////////////////////////////////////////////////////////////////////////////
+void TeensySPITransport::beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+  SPI.beginTransaction(SPISettings(clock, bitOrder, dataMode));
+}
+
+void TeensySPITransport::endTransaction() {
+  SPI.endTransaction();
+}
+
+uint8_t TeensySPITransport::transfer(uint8_t data) {
+  return(SPI.transfer(data));
+}
+
+void TeensySPITransport::end() {
+  SPI.end();
+}
+
+void TeensySPITransport::delayMicroseconds(uint32_t us) {
+  ::delayMicroseconds(us);
+}
+
+void TeensySPITransport::delay(uint32_t ms) {
+  ::delay(ms);
+}
+
+uint32_t TeensySPITransport::micros() {
+  return(::micros());
+}
+
+#endif
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SPITransport.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Pluggable SPI/GPIO/timing interface used by the ADIS16480 and ADF7242 drivers. The drivers never
+//  touch SPI, digitalWrite, or delayMicroseconds directly, so the same driver sources run on the
+//  Teensy (TeensySPITransport) and on a Linux host (HostSPITransport, see HostSPITransport.h).
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPITransport_h
+#define SPITransport_h
+
+#if defined(ARDUINO)
+#include "Arduino.h"
+#include <SPI.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+
+// Arduino constants used by the drivers when building off target
+#ifndef HIGH
+#define HIGH 0x1
+#endif
+#ifndef LOW
+#define LOW 0x0
+#endif
+#ifndef INPUT
+#define INPUT 0x0
+#endif
+#ifndef OUTPUT
+#define OUTPUT 0x1
+#endif
+#ifndef MSBFIRST
+#define MSBFIRST 1
+#endif
+#ifndef SPI_MODE0
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+#endif
+#endif
+
+// SPITransport class definition
+class SPITransport {
+public:
+  constexpr SPITransport() {}
+
+  // Configure a GPIO pin as INPUT or OUTPUT
+  virtual void pinMode(int pin, int mode) = 0;
+
+  // Drive a GPIO pin (chip selects, resets) HIGH or LOW
+  virtual void digitalWrite(int pin, int level) = 0;
+
+  // Read a GPIO pin (data ready, IRQ)
+  virtual int digitalRead(int pin) = 0;
+
+  // Load clock rate, bit order, and data mode for the following transfers
+  virtual void beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) = 0;
+
+  // Release the settings loaded by beginTransaction()
+  virtual void endTransaction() = 0;
+
+  // Exchange one byte on the bus
+  virtual uint8_t transfer(uint8_t data) = 0;
+
+  // Shut the SPI peripheral down
+  virtual void end() = 0;
+
+  // Busy wait for a number of microseconds
+  virtual void delayMicroseconds(uint32_t us) = 0;
+
+  // Busy wait for a number of milliseconds
+  virtual void delay(uint32_t ms) = 0;
+
+  // Free running microsecond time base
+  virtual uint32_t micros() = 0;
+};
+
+#if defined(ARDUINO)
+// TeensySPITransport class definition. Thin wrapper around the Teensyduino SPI and GPIO calls.
+class TeensySPITransport : public SPITransport {
+public:
+  constexpr TeensySPITransport() {}
+
+  void pinMode(int pin, int mode);
+  void digitalWrite(int pin, int level);
+  int digitalRead(int pin);
+  void beginTransaction(uint32_t clock, uint8_t bitOrder, uint8_t dataMode);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+  void end();
+  void delayMicroseconds(uint32_t us);
+  void delay(uint32_t ms);
+  uint32_t micros();
+};
+
+// Default transport shared by every driver instance on the board
+extern TeensySPITransport TeensySPI;
+#endif
+
+#endif
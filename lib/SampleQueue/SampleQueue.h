@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SampleQueue.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Single-producer/single-consumer lock-free ring buffer. The producer is an interrupt handler (or a
+//  thread standing in for one on the host), the consumer is loop(). Neither side ever blocks or
+//  disables interrupts: each index is written by exactly one side and published with release/acquire
+//  ordering, which compiles to plain loads/stores plus DMB on the Cortex-M4.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SampleQueue_h
+#define SampleQueue_h
+
+#include <stdint.h>
+
+// SampleQueue class definition. N must be a power of two.
+template <typename T, uint16_t N>
+class SampleQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SampleQueue size must be a power of two");
+
+public:
+  SampleQueue() : _head(0), _tail(0), _overflows(0), _highWater(0) {}
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Producer side. Copies item into the queue. Returns false and counts an
+  // overflow if the queue is full; the newest item is the one dropped.
+  ////////////////////////////////////////////////////////////////////////////
+  bool push(const T &item) {
+    uint32_t head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+    if ((uint32_t)(head - tail) >= N) {
+      __atomic_store_n(&_overflows, _overflows + 1, __ATOMIC_RELAXED);
+      return(false);
+    }
+    _buf[head & (N - 1)] = item;
+    __atomic_store_n(&_head, head + 1, __ATOMIC_RELEASE);
+    uint16_t depth = (uint16_t)(head + 1 - tail);
+    if (depth > _highWater) {
+      __atomic_store_n(&_highWater, depth, __ATOMIC_RELAXED);
+    }
+    return(true);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Consumer side. Copies the oldest item out. Returns false if empty.
+  ////////////////////////////////////////////////////////////////////////////
+  bool pop(T &item) {
+    uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      return(false);
+    }
+    item = _buf[tail & (N - 1)];
+    __atomic_store_n(&_tail, tail + 1, __ATOMIC_RELEASE);
+    return(true);
+  }
+
+  // Number of queued items (either side)
+  uint16_t size() const {
+    return((uint16_t)(__atomic_load_n(&_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&_tail, __ATOMIC_ACQUIRE)));
+  }
+
+  // Queue capacity
+  uint16_t capacity() const {
+    return(N);
+  }
+
+  // Items dropped because the queue was full
+  uint32_t overflows() const {
+    return(__atomic_load_n(&_overflows, __ATOMIC_RELAXED));
+  }
+
+  // Deepest the queue has been since construction
+  uint16_t highWater() const {
+    return(__atomic_load_n(&_highWater, __ATOMIC_RELAXED));
+  }
+
+private:
+  T _buf[N];
+  uint32_t _head; // Free running write index, owned by the producer
+  uint32_t _tail; // Free running read index, owned by the consumer
+  uint32_t _overflows; // Written by the producer only
+  uint16_t _highWater; // Written by the producer only
+};
+
+#endif
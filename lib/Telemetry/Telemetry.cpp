@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Telemetry.cpp
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Telemetry.h"
+
+// CRC-16/CCITT-FALSE, one nibble at a time (32 bytes of table instead of 512)
+static const uint16_t crcNibble[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+////////////////////////////////////////////////////////////////////////////
+// uint16_t telemetryCRC(const uint8_t* data, size_t len, uint16_t crc)
+////////////////////////////////////////////////////////////////////////////
+// data - bytes to checksum
+// len - number of bytes
+// crc - running CRC, 0xFFFF to start a new one
+// return - updated CRC
+////////////////////////////////////////////////////////////////////////////
+uint16_t telemetryCRC(const uint8_t* data, size_t len, uint16_t crc) {
+  for (size_t i = 0; i < len; ++i) {
+    crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+  return(crc);
+}
+
+// COBS encoder writing straight into the caller's buffer
+struct CobsWriter {
+  uint8_t* out;
+  size_t size;
+  size_t pos; // Next free byte
+  size_t code; // Position of the current block's code byte
+  bool overflow;
+
+  CobsWriter(uint8_t* o, size_t s) : out(o), size(s), pos(1), code(0), overflow(s < 2) {}
+
+  void put(uint8_t b) {
+    if (overflow) {
+      return;
+    }
+    if (b != 0) {
+      if (pos >= size) {
+        overflow = true;
+        return;
+      }
+      out[pos++] = b;
+    }
+    // Close the block on a zero or when it reaches 254 data bytes
+    if (b == 0 || pos - code == 0xFF) {
+      if (pos >= size) {
+        overflow = true;
+        return;
+      }
+      out[code] = (uint8_t)(pos - code);
+      code = pos++;
+    }
+  }
+
+  void put(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      put(data[i]);
+    }
+  }
+
+  // Close the last block and append the delimiter. Returns the encoded size.
+  size_t finish() {
+    if (overflow || pos >= size) {
+      return(0);
+    }
+    out[code] = (uint8_t)(pos - code);
+    out[pos++] = 0x00;
+    return(pos);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// size_t telemetryEncode(uint8_t type, uint16_t seq, const uint8_t* payload,
+//                        uint8_t len, uint8_t* out, size_t outSize)
+////////////////////////////////////////////////////////////////////////////
+// Builds, checksums, and COBS encodes a frame in a single pass directly
+// into out. No intermediate copy of the payload is made.
+////////////////////////////////////////////////////////////////////////////
+// type - TELEM_* message type
+// seq - frame sequence number
+// payload - message body
+// len - payload length, 0..TELEMETRY_MAX_PAYLOAD
+// out - destination, TELEMETRY_ENCODED_SIZE(len) bytes are enough
+// outSize - size of out
+// return - encoded size including the 0x00 delimiter, 0 if it did not fit
+////////////////////////////////////////////////////////////////////////////
+size_t telemetryEncode(uint8_t type, uint16_t seq, const uint8_t* payload, uint8_t len, uint8_t* out, size_t outSize) {
+  if (len > TELEMETRY_MAX_PAYLOAD) {
+    return(0);
+  }
+  uint8_t header[TELEMETRY_HEADER] = {TELEMETRY_VERSION, type, (uint8_t)(seq & 0xFF), (uint8_t)(seq >> 8), len};
+  uint16_t crc = telemetryCRC(header, TELEMETRY_HEADER);
+  crc = telemetryCRC(payload, len, crc);
+  uint8_t trailer[TELEMETRY_CRC] = {(uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8)};
+
+  CobsWriter w(out, outSize);
+  w.put(header, TELEMETRY_HEADER);
+  w.put(payload, len);
+  w.put(trailer, TELEMETRY_CRC);
+  return(w.finish());
+}
+
+////////////////////////////////////////////////////////////////////////////
+// TelemetryStatus telemetryDecode(uint8_t* buf, size_t len, TelemetryFrame &frame)
+////////////////////////////////////////////////////////////////////////////
+// Undoes the COBS stuffing in place (the decoded frame is never longer
+// than the encoded one), then checks length, CRC, and version. On success
+// frame.payload points into buf, so nothing is copied.
+////////////////////////////////////////////////////////////////////////////
+// buf - encoded frame without its 0x00 delimiter, overwritten
+// len - encoded length
+// frame - receives the header fields and payload pointer
+// return - TELEMETRY_OK or the reason the frame was rejected
+////////////////////////////////////////////////////////////////////////////
+TelemetryStatus telemetryDecode(uint8_t* buf, size_t len, TelemetryFrame &frame) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < len) {
+    uint8_t code = buf[in++];
+    if (code == 0 || in + code - 1 > len) {
+      return(TELEMETRY_BAD_COBS);
+    }
+    for (uint8_t i = 1; i < code; ++i) {
+      buf[out++] = buf[in++];
+    }
+    // A block shorter than 254 data bytes stands for a zero, except at the very end
+    if (code != 0xFF && in < len) {
+      buf[out++] = 0x00;
+    }
+  }
+
+  if (out < TELEMETRY_HEADER + TELEMETRY_CRC || buf[4] != out - TELEMETRY_HEADER - TELEMETRY_CRC) {
+    return(TELEMETRY_BAD_LENGTH);
+  }
+  uint16_t crc = buf[out - 2] | (buf[out - 1] << 8);
+  if (telemetryCRC(buf, out - TELEMETRY_CRC) != crc) {
+    return(TELEMETRY_BAD_CRC);
+  }
+  if (buf[0] != TELEMETRY_VERSION) {
+    return(TELEMETRY_BAD_VERSION);
+  }
+
+  frame.version = buf[0];
+  frame.type = buf[1];
+  frame.seq = buf[2] | (buf[3] << 8);
+  frame.length = buf[4];
+  frame.payload = buf + TELEMETRY_HEADER;
+  return(TELEMETRY_OK);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// uint8_t telemetryBatchRecords(const TelemetryFrame &frame, uint8_t &recordType,
+//                               uint8_t &recordSize, const uint8_t* &records)
+////////////////////////////////////////////////////////////////////////////
+// frame - decoded TELEM_BATCH frame
+// recordType - receives the TELEM_* type of every record
+// recordSize - receives the size of one record
+// records - receives a pointer to the first record, inside the frame
+// return - number of records, 0 if the frame is not a well formed batch
+////////////////////////////////////////////////////////////////////////////
+uint8_t telemetryBatchRecords(const TelemetryFrame &frame, uint8_t &recordType, uint8_t &recordSize, const uint8_t* &records) {
+  if (frame.type != TELEM_BATCH || frame.length < TELEMETRY_BATCH_HEADER) {
+    return(0);
+  }
+  recordType = frame.payload[0];
+  recordSize = frame.payload[1];
+  records = frame.payload + TELEMETRY_BATCH_HEADER;
+  uint8_t bytes = frame.length - TELEMETRY_BATCH_HEADER;
+  if (recordSize == 0 || bytes % recordSize != 0) {
+    return(0);
+  }
+  return(bytes / recordSize);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// TelemetryBatch(uint8_t recordType, uint8_t recordSize, uint8_t maxRecords,
+//                uint32_t deadlineMicros, size_t maxEncoded)
+////////////////////////////////////////////////////////////////////////////
+// recordType - TELEM_* type of every record
+// recordSize - size of one record in bytes
+// maxRecords - records sent per batch when the deadline does not cut in
+// deadlineMicros - longest a record may wait for the batch to fill [us]
+// maxEncoded - largest encoded frame the link can carry
+////////////////////////////////////////////////////////////////////////////
+TelemetryBatch::TelemetryBatch(uint8_t recordType, uint8_t recordSize, uint8_t maxRecords, uint32_t deadlineMicros,
+                               size_t maxEncoded) {
+  _payload[0] = recordType;
+  _payload[1] = recordSize;
+  _recordSize = recordSize;
+  uint8_t fits = fit(recordSize, maxEncoded);
+  _maxRecords = (maxRecords == 0 || maxRecords > fits) ? fits : maxRecords;
+  _count = 0;
+  _deadline = deadlineMicros;
+  _first = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Most records of recordSize bytes that fit a batch payload whose encoded
+// frame is at most maxEncoded bytes
+////////////////////////////////////////////////////////////////////////////
+uint8_t TelemetryBatch::fit(uint8_t recordSize, size_t maxEncoded) {
+  if (recordSize == 0) {
+    return(0);
+  }
+  uint8_t n = (TELEMETRY_MAX_PAYLOAD - TELEMETRY_BATCH_HEADER) / recordSize;
+  while (n > 0 && (size_t)TELEMETRY_ENCODED_SIZE(TELEMETRY_BATCH_HEADER + n * recordSize) > maxEncoded) {
+    --n;
+  }
+  return(n);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Copies record into the batch. A full batch drops the record; callers
+// send as soon as add() returns true so that never happens.
+////////////////////////////////////////////////////////////////////////////
+// record - recordSize bytes
+// timestamp - when the record was taken [us]
+// return - true when the batch is full or the oldest record is due
+////////////////////////////////////////////////////////////////////////////
+bool TelemetryBatch::add(const void* record, uint32_t timestamp) {
+  if (_count >= _maxRecords) {
+    return(true);
+  }
+  if (_count == 0) {
+    _first = timestamp;
+  }
+  const uint8_t* src = (const uint8_t*)record;
+  uint8_t* dst = _payload + TELEMETRY_BATCH_HEADER + _count * _recordSize;
+  for (uint8_t i = 0; i < _recordSize; ++i) {
+    dst[i] = src[i];
+  }
+  ++_count;
+  return(_count >= _maxRecords || due(timestamp));
+}
+
+// True when the oldest record has waited deadline microseconds
+bool TelemetryBatch::due(uint32_t now) const {
+  return(_count > 0 && (uint32_t)(now - _first) >= _deadline);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// seq - frame sequence number
+// out - destination for the encoded frame
+// outSize - size of out
+// return - encoded size including the 0x00 delimiter, 0 if empty
+////////////////////////////////////////////////////////////////////////////
+size_t TelemetryBatch::encode(uint16_t seq, uint8_t* out, size_t outSize) {
+  if (_count == 0) {
+    return(0);
+  }
+  size_t len = telemetryEncode(TELEM_BATCH, seq, _payload, TELEMETRY_BATCH_HEADER + _count * _recordSize, out, outSize);
+  _count = 0;
+  return(len);
+}
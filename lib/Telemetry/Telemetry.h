@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Analog Devices, Inc.
+//  October 2026
+//  Written for the TeensyDuino Platform
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Telemetry.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  This file is part of Interfacing ADIS16480 and ADF7242 with Arduino example.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is free software: you can redistribute it
+//  and/or modify it under the terms of the GNU Lesser Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Interfacing ADIS16480 and ADF7242 with Arduino example is distributed in the hope that it will be
+//  useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser Public License
+//  along with Interfacing ADIS16480 and ADF7242 with Arduino example.  If not, see
+//  <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Framed binary telemetry shared by the TX and RX sketches and the host tools.
+//
+//  Frame layout before stuffing (multi-byte fields little endian):
+//
+//    [0]      version       TELEMETRY_VERSION
+//    [1]      type          TELEM_* message type
+//    [2..3]   seq           frame sequence number, wraps at 0xFFFF
+//    [4]      length        payload length, 0..TELEMETRY_MAX_PAYLOAD
+//    [5..]    payload
+//    [+0..1]  crc           CRC-16/CCITT-FALSE over version..payload
+//
+//  The frame is COBS encoded so it contains no 0x00 bytes, then terminated with a single 0x00
+//  delimiter. A receiver that loses sync simply waits for the next 0x00. Any data value, including
+//  0xFF, can be carried.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef Telemetry_h
+#define Telemetry_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TELEMETRY_VERSION 2 // Bumped whenever the header or a payload layout changes
+#define TELEMETRY_HEADER 5 // version, type, seq, length
+#define TELEMETRY_CRC 2 // CRC-16 trailer
+#define TELEMETRY_MAX_PAYLOAD 240 // Largest payload carried by one frame
+
+// Largest unstuffed frame, and largest encoded frame including COBS overhead and delimiter
+#define TELEMETRY_MAX_RAW (TELEMETRY_HEADER + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC)
+#define TELEMETRY_MAX_ENCODED (TELEMETRY_MAX_RAW + TELEMETRY_MAX_RAW / 254 + 2)
+
+// Encoded size of a frame carrying len payload bytes
+#define TELEMETRY_ENCODED_SIZE(len) \
+  ((TELEMETRY_HEADER + (len) + TELEMETRY_CRC) + (TELEMETRY_HEADER + (len) + TELEMETRY_CRC) / 254 + 2)
+
+// Message types
+#define TELEM_ATTITUDE 0x01 // TelemetryAttitude
+#define TELEM_SAMPLE 0x02 // ADIS16480Sample (see ADIS16480.h)
+#define TELEM_BATCH 0x03 // Record type, record size, then fixed size records of that type
+#define TELEM_TIMED_ATTITUDE 0x04 // TelemetryTimedAttitude
+#define TELEM_PROFILE 0x05 // ProfileRecord (see Profiler.h), sent on request
+
+#define TELEMETRY_BATCH_HEADER 2 // Record type and record size leading a TELEM_BATCH payload
+
+// Full resolution Euler angles (ROLL_C23_OUT, PITCH_C31_OUT, YAW_C32_OUT)
+struct __attribute__((packed)) TelemetryAttitude {
+  int16_t roll;
+  int16_t pitch;
+  int16_t yaw;
+};
+
+// Euler angles stamped with micros() at the data ready edge, the record aggregated over the radio
+struct __attribute__((packed)) TelemetryTimedAttitude {
+  uint32_t timestamp;
+  int16_t roll;
+  int16_t pitch;
+  int16_t yaw;
+};
+
+// Decoded frame. payload points into the buffer passed to telemetryDecode().
+struct TelemetryFrame {
+  uint8_t version;
+  uint8_t type;
+  uint16_t seq;
+  uint8_t length;
+  const uint8_t* payload;
+};
+
+// Frame decode result
+enum TelemetryStatus {
+  TELEMETRY_OK = 0,
+  TELEMETRY_BAD_COBS, // Stuffing is inconsistent (truncated or merged frames)
+  TELEMETRY_BAD_LENGTH, // Header length disagrees with the frame size
+  TELEMETRY_BAD_CRC, // Corrupted frame
+  TELEMETRY_BAD_VERSION // Produced by an incompatible firmware
+};
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of len bytes, continuing from crc
+uint16_t telemetryCRC(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+
+// Encode a frame straight into out, including the trailing 0x00. Returns bytes written, 0 if it does not fit.
+size_t telemetryEncode(uint8_t type, uint16_t seq, const uint8_t* payload, uint8_t len, uint8_t* out, size_t outSize);
+
+// Decode one frame (delimiter already stripped) in place. frame.payload points into buf.
+TelemetryStatus telemetryDecode(uint8_t* buf, size_t len, TelemetryFrame &frame);
+
+// Point records at the records of a TELEM_BATCH frame. Returns the record count, 0 if malformed.
+uint8_t telemetryBatchRecords(const TelemetryFrame &frame, uint8_t &recordType, uint8_t &recordSize, const uint8_t* &records);
+
+// TelemetryBatch class definition. Packs fixed size records into one TELEM_BATCH frame so the
+// per-packet radio overhead (preamble, sync word, PHR, FCS, RC_TX turnaround) is paid once per
+// batch instead of once per sample.
+class TelemetryBatch {
+
+public:
+  // Batch of up to maxRecords records, cut short when the oldest record is deadlineMicros old.
+  // maxRecords is clipped so the encoded frame never exceeds maxEncoded bytes.
+  TelemetryBatch(uint8_t recordType, uint8_t recordSize, uint8_t maxRecords, uint32_t deadlineMicros,
+                 size_t maxEncoded = TELEMETRY_MAX_ENCODED);
+
+  // Most records of recordSize bytes whose batch frame encodes to maxEncoded bytes or less
+  static uint8_t fit(uint8_t recordSize, size_t maxEncoded);
+
+  // Append a record taken at timestamp [us]. Returns true when the batch is full or due.
+  bool add(const void* record, uint32_t timestamp);
+
+  // True when the batch holds records and the oldest one has reached the deadline
+  bool due(uint32_t now) const;
+
+  // Encode the batch as a TELEM_BATCH frame and empty it. Returns the encoded size, 0 if empty.
+  size_t encode(uint16_t seq, uint8_t* out, size_t outSize);
+
+  // Records currently held
+  uint8_t count() const {
+    return(_count);
+  }
+
+  // Records per batch after clipping
+  uint8_t capacity() const {
+    return(_maxRecords);
+  }
+
+private:
+  uint8_t _payload[TELEMETRY_MAX_PAYLOAD];
+  uint8_t _recordSize;
+  uint8_t _maxRecords;
+  uint8_t _count;
+  uint32_t _deadline;
+  uint32_t _first; // Timestamp of the oldest record
+};
+
+#endif